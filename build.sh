@@ -12,6 +12,12 @@ make
 # Build shaders
 glslangValidator -V ../shaders/*
 
+# Convert meshes
+./stirling_mesh ../assets/quad.obj quad.mesh
+
+# Pack assets
+./stirling_pack assets.pak vert.spv geom.spv frag.spv quad.mesh
+
 #Run Stirling Engine Demo
 echo
 ./stirling
@@ -2,13 +2,19 @@
 #extension GL_ARB_separate_shader_objects : enable
 
 layout(binding = 0) uniform UniformBufferObject {
-    mat4 model;
     mat4 view;
     mat4 projection;
 } ubo;
 
+layout(push_constant) uniform DrawConstants {
+    mat4 model;
+    uint object_index;
+} draw;
+
 layout(location = 0) in vec3 in_position;
 layout(location = 1) in vec3 in_color;
+layout(location = 2) in vec2 in_normal;
+layout(location = 3) in vec2 in_uv;
 
 layout(location = 0) out vec3 frag_color;
 
@@ -18,6 +24,6 @@ out gl_PerVertex {
 
 void main() {
     frag_color = in_color;
-    gl_Position = ubo.projection * ubo.view * ubo.model * vec4(in_position, 1.0);
+    gl_Position = ubo.projection * ubo.view * draw.model * vec4(in_position, 1.0);
     frag_color = in_color;
 }
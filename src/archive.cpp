@@ -0,0 +1,276 @@
+#include "archive.hpp"
+#include "hash.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#ifdef STIRLING_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef STIRLING_ZSTD
+#include <zstd.h>
+#endif
+
+namespace stirling {
+
+    namespace {
+
+        inline uint64_t align(uint64_t offset, uint64_t alignment) {
+            return (offset + alignment - 1) & ~(alignment - 1);
+        }
+
+        // Written so a crafted offset or size cannot wrap around and pass
+        inline bool is_in_file(uint64_t offset, uint64_t size, uint64_t file_size) {
+            return offset <= file_size && size <= file_size - offset;
+        }
+
+        // Stored entries are used in place, so their size must also be the stored size
+        inline bool is_valid_entry(const ArchiveEntry& entry, uint64_t file_size) {
+            return is_in_file(entry.offset, entry.stored_size, file_size) &&
+                   (entry.compression != ArchiveCompression::none || entry.size == entry.stored_size);
+        }
+
+        inline uint32_t get_table_capacity(uint32_t entry_count) {
+            // Keep load factor at or below one half so probe sequences stay short
+            uint32_t capacity = 1;
+            while (capacity < entry_count * 2) capacity <<= 1;
+            return capacity;
+        }
+
+        std::vector<uint8_t> compress(ArchiveCompression compression, const void* data, size_t size) {
+            switch (compression) {
+#ifdef STIRLING_LZ4
+            case ArchiveCompression::lz4: {
+                std::vector<uint8_t> compressed(LZ4_compressBound(static_cast<int>(size)));
+                const auto compressed_size = LZ4_compress_default(
+                    static_cast<const char*>(data),
+                    reinterpret_cast<char*>(compressed.data()),
+                    static_cast<int>(size),
+                    static_cast<int>(compressed.size())
+                );
+                if (compressed_size <= 0) throw "Failed to compress archive entry.";
+                compressed.resize(compressed_size);
+                return compressed;
+            }
+#endif
+#ifdef STIRLING_ZSTD
+            case ArchiveCompression::zstd: {
+                std::vector<uint8_t> compressed(ZSTD_compressBound(size));
+                const auto compressed_size = ZSTD_compress(compressed.data(), compressed.size(), data, size, 19);
+                if (ZSTD_isError(compressed_size)) throw "Failed to compress archive entry.";
+                compressed.resize(compressed_size);
+                return compressed;
+            }
+#endif
+            case ArchiveCompression::none: {
+                const auto bytes = static_cast<const uint8_t*>(data);
+                return {bytes, bytes + size};
+            }
+            default:
+                throw "Archive compression not supported by this build.";
+            }
+        }
+
+        void decompress(ArchiveCompression compression, const uint8_t* src, size_t src_size, void* dst, size_t dst_size) {
+            switch (compression) {
+#ifdef STIRLING_LZ4
+            case ArchiveCompression::lz4:
+                if (LZ4_decompress_safe(
+                    reinterpret_cast<const char*>(src),
+                    static_cast<char*>(dst),
+                    static_cast<int>(src_size),
+                    static_cast<int>(dst_size)
+                ) != static_cast<int>(dst_size)) {
+                    throw "Failed to decompress archive entry.";
+                }
+                return;
+#endif
+#ifdef STIRLING_ZSTD
+            case ArchiveCompression::zstd:
+                if (ZSTD_decompress(dst, dst_size, src, src_size) != dst_size) {
+                    throw "Failed to decompress archive entry.";
+                }
+                return;
+#endif
+            case ArchiveCompression::none:
+                if (src_size != dst_size) throw "Malformed archive.";
+                memcpy(dst, src, dst_size);
+                return;
+            default:
+                throw "Archive compression not supported by this build.";
+            }
+        }
+
+    }
+
+    uint64_t hash_archive_name(const char* name) {
+        const auto hash = hash_bytes(name, strlen(name));
+        return hash != 0 ? hash : 1;
+    }
+
+    uint32_t check_archive_name(const char* name) {
+        // Seeded differently from the table hash, so names colliding on one rarely collide on both
+        const auto hash = hash_bytes(name, strlen(name), hash_value(archive_magic));
+        return static_cast<uint32_t>(hash >> 32) ^ static_cast<uint32_t>(hash);
+    }
+
+    bool is_compression_supported(ArchiveCompression compression) {
+        switch (compression) {
+        case ArchiveCompression::none: return true;
+#ifdef STIRLING_LZ4
+        case ArchiveCompression::lz4: return true;
+#endif
+#ifdef STIRLING_ZSTD
+        case ArchiveCompression::zstd: return true;
+#endif
+        default: return false;
+        }
+    }
+
+    Archive::Archive(const char* file_name) :
+        file (file_name) {
+
+        if (file.size() < sizeof(ArchiveHeader)) throw "Malformed archive.";
+        ArchiveHeader header;
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, archive_magic, sizeof(archive_magic)) != 0) throw "Not an archive.";
+        if (header.version != archive_version) throw "Unsupported archive version.";
+        if (header.table_capacity == 0 || (header.table_capacity & (header.table_capacity - 1)) != 0 ||
+            header.table_offset % alignof(ArchiveEntry) != 0 ||
+            !is_in_file(header.table_offset, uint64_t(header.table_capacity) * sizeof(ArchiveEntry), file.size())) {
+            throw "Malformed archive.";
+        }
+
+        // Table of contents is used in place, straight from the mapping
+        table = reinterpret_cast<const ArchiveEntry*>(file.data() + header.table_offset);
+        table_mask = header.table_capacity - 1;
+        entry_count = header.entry_count;
+    }
+
+    const ArchiveEntry* Archive::find(const char* name) const {
+        // Hashes are unique within an archive, so a hash match with another name check is a
+        // different name. Probing stops after one pass, in case a malformed table has no empty slot.
+        const auto hash = hash_archive_name(name);
+        auto slot = static_cast<uint32_t>(hash) & table_mask;
+        for (uint32_t probe = 0; probe <= table_mask; ++probe, slot = (slot + 1) & table_mask) {
+            const auto& entry = table[slot];
+            if (entry.hash == hash) return entry.name_check == check_archive_name(name) ? &entry : nullptr;
+            if (entry.hash == 0) return nullptr;
+        }
+        return nullptr;
+    }
+
+    const ArchiveEntry& Archive::get(const char* name) const {
+        const auto entry = find(name);
+        if (entry == nullptr) throw "Archive entry not found.";
+        if (!is_valid_entry(*entry, file.size())) throw "Malformed archive.";
+        return *entry;
+    }
+
+    ArchiveBlob Archive::load(const char* name) const {
+        const auto& entry = get(name);
+        if (entry.compression == ArchiveCompression::none) {
+            return {file.data() + entry.offset, static_cast<size_t>(entry.size), nullptr};
+        }
+
+        std::unique_ptr<uint8_t[]> buffer{new uint8_t[entry.size]};
+        read(entry, buffer.get());
+        const auto data = buffer.get();
+        return {data, static_cast<size_t>(entry.size), std::move(buffer)};
+    }
+
+    void Archive::read(const ArchiveEntry& entry, void* dst) const {
+        if (!is_valid_entry(entry, file.size())) throw "Malformed archive.";
+        decompress(
+            entry.compression,
+            file.data() + entry.offset,
+            static_cast<size_t>(entry.stored_size),
+            dst,
+            static_cast<size_t>(entry.size)
+        );
+    }
+
+    void ArchiveBuilder::add(
+        const std::string& name,
+        const void*        data,
+        size_t             size,
+        ArchiveCompression compression) {
+
+        const auto hash = hash_archive_name(name.c_str());
+        for (const auto& entry : entries) {
+            if (entry.hash == hash) throw "Duplicate or colliding archive entry name.";
+        }
+
+        auto stored = compress(compression, data, size);
+
+        // Keep incompressible entries raw so they can be used in place
+        if (compression != ArchiveCompression::none && stored.size() >= size) {
+            compression = ArchiveCompression::none;
+            stored = compress(compression, data, size);
+        }
+
+        entries.push_back({
+            .name        = name,
+            .hash        = hash,
+            .size        = size,
+            .compression = compression,
+            .data        = std::move(stored)
+        });
+    }
+
+    void ArchiveBuilder::write(const char* file_name) const {
+        const auto entry_count = static_cast<uint32_t>(entries.size());
+        const auto table_capacity = get_table_capacity(entry_count);
+        const auto table_offset = align(sizeof(ArchiveHeader), archive_alignment);
+
+        // Place entries into the open-addressed table and lay out blobs after it
+        std::vector<ArchiveEntry> table(table_capacity, ArchiveEntry{});
+        std::vector<uint64_t> offsets;
+        offsets.reserve(entries.size());
+        auto offset = align(table_offset + table_capacity * sizeof(ArchiveEntry), archive_alignment);
+        for (const auto& entry : entries) {
+            auto slot = static_cast<uint32_t>(entry.hash) & (table_capacity - 1);
+            while (table[slot].hash != 0) slot = (slot + 1) & (table_capacity - 1);
+
+            table[slot] = {
+                .hash        = entry.hash,
+                .offset      = offset,
+                .size        = entry.size,
+                .stored_size = entry.data.size(),
+                .compression = entry.compression,
+                .name_check  = check_archive_name(entry.name.c_str())
+            };
+            offsets.push_back(offset);
+            offset = align(offset + entry.data.size(), archive_alignment);
+        }
+
+        ArchiveHeader header {
+            .version        = archive_version,
+            .entry_count    = entry_count,
+            .table_capacity = table_capacity,
+            .table_offset   = table_offset
+        };
+        memcpy(header.magic, archive_magic, sizeof(archive_magic));
+
+        std::ofstream file{file_name, std::ios::binary | std::ios::out | std::ios::trunc};
+        if (!file.is_open()) throw "Failed to open file.";
+
+        const auto pad_to = [&file](uint64_t position) {
+            static const char zeros[archive_alignment] = {};
+            const auto padding = position - static_cast<uint64_t>(file.tellp());
+            file.write(zeros, padding);
+        };
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        pad_to(table_offset);
+        file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(ArchiveEntry));
+        for (size_t i = 0; i < entries.size(); ++i) {
+            pad_to(offsets[i]);
+            file.write(reinterpret_cast<const char*>(entries[i].data.data()), entries[i].data.size());
+        }
+
+        if (!file) throw "Failed to write archive.";
+    }
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace stirling {
+
+    enum class ArchiveCompression : uint32_t {
+        none = 0,
+        lz4  = 1,
+        zstd = 2
+    };
+
+    // On-disk layout: header, open-addressed table of contents indexed by name hash, then blobs
+    // aligned to archive_alignment so uncompressed entries can be consumed in place.
+    struct ArchiveHeader {
+        uint8_t  magic[4];
+        uint32_t version;
+        uint32_t entry_count;
+        uint32_t table_capacity;
+        uint64_t table_offset;
+    };
+
+    struct ArchiveEntry {
+        uint64_t           hash;
+        uint64_t           offset;
+        uint64_t           size;
+        uint64_t           stored_size;
+        ArchiveCompression compression;
+        uint32_t           name_check; // Independent hash of the name, rejects lookups colliding on hash
+    };
+
+    constexpr uint8_t  archive_magic[4]  = { 'S', 'T', 'P', 'K' };
+    constexpr uint32_t archive_version   = 2;
+    constexpr uint64_t archive_alignment = 64;
+
+    // Never zero, zero marks an empty table slot
+    uint64_t hash_archive_name(const char* name);
+    uint32_t check_archive_name(const char* name);
+
+    bool is_compression_supported(ArchiveCompression compression);
+
+    // Entry contents, either borrowed from the archive mapping or owned after decompression
+    struct ArchiveBlob {
+        const uint8_t*             data;
+        size_t                     size;
+        std::unique_ptr<uint8_t[]> buffer;
+    };
+
+    struct Archive {
+        Archive(const char* file_name);
+
+        const ArchiveEntry* find(const char* name) const;
+        inline bool contains(const char* name) const { return find(name) != nullptr; }
+        inline uint32_t size() const { return entry_count; }
+
+        // Uncompressed entries are returned without copying
+        ArchiveBlob load(const char* name) const;
+
+        // Writes decompressed entry contents to dst, which must hold entry.size bytes
+        void read(const ArchiveEntry& entry, void* dst) const;
+
+    private:
+        FileView            file;
+        const ArchiveEntry* table;
+        uint32_t            table_mask;
+        uint32_t            entry_count;
+
+        const ArchiveEntry& get(const char* name) const;
+    };
+
+    struct ArchiveBuilder {
+        void add(
+            const std::string& name,
+            const void*        data,
+            size_t             size,
+            ArchiveCompression compression = ArchiveCompression::none);
+
+        void write(const char* file_name) const;
+
+    private:
+        struct PendingEntry {
+            std::string          name;
+            uint64_t             hash;
+            uint64_t             size;
+            ArchiveCompression   compression;
+            std::vector<uint8_t> data;
+        };
+
+        std::vector<PendingEntry> entries;
+    };
+
+}
@@ -0,0 +1,297 @@
+#include "bounding_volume_hierarchy.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace stirling {
+
+    namespace {
+
+        // Parent of the root and child index of leaves
+        constexpr uint32_t no_node = std::numeric_limits<uint32_t>::max();
+
+        // Objects per leaf, tested together by the batched box kernel
+        constexpr uint32_t leaf_size = 8;
+
+        // Objects per culling task
+        constexpr uint32_t cull_grain_size = 4096;
+
+        // Growth of the summed node surface area since the last build that triggers a rebuild
+        constexpr double rebuild_area_ratio = 2.0;
+
+        enum class Containment : uint32_t {
+            outside      = 0,
+            intersecting = 1,
+            inside       = 2
+        };
+
+        Containment classify(const Frustum& frustum, const glm::vec3& min, const glm::vec3& max) {
+            const auto center = (min + max) * 0.5f;
+            const auto extent = (max - min) * 0.5f;
+
+            auto containment = Containment::inside;
+            for (const auto& plane : frustum.planes) {
+                const glm::vec3 normal(plane);
+                const auto distance = glm::dot(normal, center) + plane.w;
+                const auto reach = glm::dot(glm::abs(normal), extent);
+                if (distance + reach < 0.0f) return Containment::outside;
+                if (distance - reach < 0.0f) containment = Containment::intersecting;
+            }
+            return containment;
+        }
+
+        double get_surface_area(const glm::vec3& min, const glm::vec3& max) {
+            const auto size = max - min;
+            const double x = size.x, y = size.y, z = size.z;
+            return 2.0 * (x * y + y * z + z * x);
+        }
+
+    }
+
+    void BoundingVolumeHierarchy::resize(uint32_t object_count) {
+        if (object_count == size()) return;
+
+        object_bounds.resize(object_count, {glm::vec3(0.0f), glm::vec3(0.0f)});
+        layout_dirty = true;
+    }
+
+    void BoundingVolumeHierarchy::set_bounds(uint32_t object, const BoundingBox& bounds) {
+        auto& current = object_bounds[object];
+        if (current.center == bounds.center && current.extent == bounds.extent) return;
+        current = bounds;
+
+        // Slots are assigned by the rebuild, which reads the object bounds
+        if (layout_dirty) return;
+
+        const auto slot = object_slots[object];
+        center_x[slot] = bounds.center.x;
+        center_y[slot] = bounds.center.y;
+        center_z[slot] = bounds.center.z;
+        extent_x[slot] = bounds.extent.x;
+        extent_y[slot] = bounds.extent.y;
+        extent_z[slot] = bounds.extent.z;
+
+        const auto leaf = object_leaves[object];
+        if (!leaf_moved[leaf]) {
+            leaf_moved[leaf] = 1;
+            moved_leaves.push_back(leaf);
+        }
+    }
+
+    void BoundingVolumeHierarchy::refit() {
+        if (layout_dirty) {
+            rebuild();
+            layout_dirty = false;
+            return;
+        }
+
+        // Walk up from every moved leaf until a node keeps its bounds
+        for (const auto leaf : moved_leaves) {
+            surface_area -= get_surface_area(nodes[leaf].min, nodes[leaf].max);
+            fit_leaf(nodes[leaf]);
+            surface_area += get_surface_area(nodes[leaf].min, nodes[leaf].max);
+            leaf_moved[leaf] = 0;
+
+            for (auto parent = nodes[leaf].parent; parent != no_node; parent = nodes[parent].parent) {
+                auto& node = nodes[parent];
+                const auto& left = nodes[node.children];
+                const auto& right = nodes[node.children + 1];
+                const auto min = glm::min(left.min, right.min);
+                const auto max = glm::max(left.max, right.max);
+                if (min == node.min && max == node.max) break;
+
+                surface_area += get_surface_area(min, max) - get_surface_area(node.min, node.max);
+                node.min = min;
+                node.max = max;
+            }
+        }
+        moved_leaves.clear();
+
+        // Refits only grow and shrink nodes, so the tree loosens as objects move apart, slowing
+        // culling in proportion to the area its nodes cover
+        if (surface_area > rebuild_area_ratio * built_area) {
+            rebuild();
+        }
+    }
+
+    void BoundingVolumeHierarchy::cull(const Frustum& frustum, std::vector<uint32_t>& visible_objects, WorkerPool* worker_pool) {
+        const auto object_count = size();
+        const auto chunk_count = (object_count + cull_grain_size - 1) / cull_grain_size;
+
+        // Every chunk writes its objects at the start of its own range, compacted afterwards
+        visible_objects.resize(object_count);
+        chunk_counts.assign(chunk_count, 0);
+
+        const auto cull_chunks = [&](uint32_t first, uint32_t last) {
+            for (auto chunk = first; chunk < last; ++chunk) {
+                const auto begin = chunk * cull_grain_size;
+                const auto end = std::min(begin + cull_grain_size, object_count);
+                chunk_counts[chunk] = static_cast<uint32_t>(cull_range(frustum, begin, end, visible_objects.data() + begin));
+            }
+        };
+
+        if (worker_pool) {
+            worker_pool->parallel_for(chunk_count, 1, cull_chunks);
+        } else {
+            cull_chunks(0, chunk_count);
+        }
+
+        size_t visible_count = 0;
+        for (uint32_t chunk = 0; chunk < chunk_count; ++chunk) {
+            const auto begin = visible_objects.begin() + chunk * cull_grain_size;
+            if (visible_count != chunk * cull_grain_size) {
+                std::copy(begin, begin + chunk_counts[chunk], visible_objects.begin() + visible_count);
+            }
+            visible_count += chunk_counts[chunk];
+        }
+        visible_objects.resize(visible_count);
+    }
+
+    void BoundingVolumeHierarchy::rebuild() {
+        const auto object_count = size();
+
+        slot_objects.resize(object_count);
+        for (uint32_t object = 0; object < object_count; ++object) {
+            slot_objects[object] = object;
+        }
+
+        object_leaves.resize(object_count);
+        nodes.clear();
+        if (object_count > 0) {
+            nodes.push_back({glm::vec3(0.0f), glm::vec3(0.0f), no_node, no_node, 0, object_count});
+            build(0, 0, object_count);
+        }
+
+        // Store boxes in tree order
+        object_slots.resize(object_count);
+        center_x.resize(object_count);
+        center_y.resize(object_count);
+        center_z.resize(object_count);
+        extent_x.resize(object_count);
+        extent_y.resize(object_count);
+        extent_z.resize(object_count);
+        for (uint32_t slot = 0; slot < object_count; ++slot) {
+            const auto object = slot_objects[slot];
+            const auto& bounds = object_bounds[object];
+            object_slots[object] = slot;
+            center_x[slot] = bounds.center.x;
+            center_y[slot] = bounds.center.y;
+            center_z[slot] = bounds.center.z;
+            extent_x[slot] = bounds.extent.x;
+            extent_y[slot] = bounds.extent.y;
+            extent_z[slot] = bounds.extent.z;
+        }
+
+        // Children follow their parents, so fitting in reverse order works bottom up
+        surface_area = 0.0;
+        for (auto i = nodes.size(); i-- > 0;) {
+            auto& node = nodes[i];
+            if (node.children == no_node) {
+                fit_leaf(node);
+            } else {
+                node.min = glm::min(nodes[node.children].min, nodes[node.children + 1].min);
+                node.max = glm::max(nodes[node.children].max, nodes[node.children + 1].max);
+            }
+            surface_area += get_surface_area(node.min, node.max);
+        }
+        built_area = surface_area;
+
+        leaf_moved.assign(nodes.size(), 0);
+        moved_leaves.clear();
+    }
+
+    void BoundingVolumeHierarchy::build(uint32_t node, uint32_t first_slot, uint32_t slot_count) {
+        const auto first = slot_objects.begin() + first_slot;
+        const auto last = first + slot_count;
+
+        if (slot_count <= leaf_size) {
+            for (auto it = first; it != last; ++it) {
+                object_leaves[*it] = node;
+            }
+            return;
+        }
+
+        // Median split along the axis the centers spread furthest on
+        glm::vec3 min(std::numeric_limits<float>::max());
+        glm::vec3 max(std::numeric_limits<float>::lowest());
+        for (auto it = first; it != last; ++it) {
+            min = glm::min(min, object_bounds[*it].center);
+            max = glm::max(max, object_bounds[*it].center);
+        }
+        const auto spread = max - min;
+        const auto axis = spread.x >= spread.y && spread.x >= spread.z ? 0 : spread.y >= spread.z ? 1 : 2;
+
+        const auto left_count = slot_count / 2;
+        std::nth_element(first, first + left_count, last, [this, axis](uint32_t lhs, uint32_t rhs) {
+            return object_bounds[lhs].center[axis] < object_bounds[rhs].center[axis];
+        });
+
+        const auto children = static_cast<uint32_t>(nodes.size());
+        nodes[node].children = children;
+        nodes.push_back({glm::vec3(0.0f), glm::vec3(0.0f), node, no_node, first_slot, left_count});
+        nodes.push_back({glm::vec3(0.0f), glm::vec3(0.0f), node, no_node, first_slot + left_count, slot_count - left_count});
+
+        build(children, first_slot, left_count);
+        build(children + 1, first_slot + left_count, slot_count - left_count);
+    }
+
+    void BoundingVolumeHierarchy::fit_leaf(Node& node) const {
+        node.min = glm::vec3(std::numeric_limits<float>::max());
+        node.max = glm::vec3(std::numeric_limits<float>::lowest());
+        for (auto slot = node.first_slot; slot < node.first_slot + node.slot_count; ++slot) {
+            const glm::vec3 center(center_x[slot], center_y[slot], center_z[slot]);
+            const glm::vec3 extent(extent_x[slot], extent_y[slot], extent_z[slot]);
+            node.min = glm::min(node.min, center - extent);
+            node.max = glm::max(node.max, center + extent);
+        }
+    }
+
+    size_t BoundingVolumeHierarchy::cull_range(const Frustum& frustum, uint32_t begin, uint32_t end, uint32_t* visible_objects) const {
+        if (nodes.empty()) return 0;
+
+        // Balanced splits keep the depth logarithmic, far below the stack size
+        uint32_t stack[64];
+        uint32_t stack_size = 0;
+        stack[stack_size++] = 0;
+
+        size_t visible_count = 0;
+        while (stack_size > 0) {
+            const auto& node = nodes[stack[--stack_size]];
+
+            // Only the part of the subtree within this task's slots
+            const auto first = std::max(node.first_slot, begin);
+            const auto last = std::min(node.first_slot + node.slot_count, end);
+            if (first >= last) continue;
+
+            const auto containment = classify(frustum, node.min, node.max);
+            if (containment == Containment::outside) continue;
+
+            // Everything below a node inside the frustum is visible without further tests
+            if (containment == Containment::inside) {
+                for (auto slot = first; slot < last; ++slot) {
+                    visible_objects[visible_count++] = slot_objects[slot];
+                }
+                continue;
+            }
+
+            if (node.children == no_node) {
+                const BoundingBoxes boxes = {
+                    center_x.data() + first, center_y.data() + first, center_z.data() + first,
+                    extent_x.data() + first, extent_y.data() + first, extent_z.data() + first
+                };
+                const auto leaf_visible = visible_objects + visible_count;
+                const auto leaf_count = cull_boxes(frustum, boxes, last - first, first, leaf_visible);
+                for (size_t i = 0; i < leaf_count; ++i) {
+                    leaf_visible[i] = slot_objects[leaf_visible[i]];
+                }
+                visible_count += leaf_count;
+                continue;
+            }
+
+            stack[stack_size++] = node.children + 1;
+            stack[stack_size++] = node.children;
+        }
+        return visible_count;
+    }
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "simd_math.hpp"
+#include "worker_pool.hpp"
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace stirling {
+
+    struct BoundingBox {
+        glm::vec3 center;
+        glm::vec3 extent;
+    };
+
+    // Bounds of the [-1, 1] cube after transform, which is where quantized mesh positions lie
+    inline BoundingBox transform_unit_box(const glm::mat4& transform) {
+        return {
+            glm::vec3(transform[3]),
+            glm::abs(glm::vec3(transform[0])) + glm::abs(glm::vec3(transform[1])) + glm::abs(glm::vec3(transform[2]))
+        };
+    }
+
+    // Axis aligned bounding boxes of objects 0 to size() - 1 in a binary tree for frustum culling.
+    // Moved objects only refit their ancestors, the tree is rebuilt after the object count changed
+    // or once refitting doubled the summed surface area of its nodes since the last build. Leaves
+    // store their boxes as contiguous arrays, so partially visible leaves are tested with the
+    // batched kernels.
+    struct BoundingVolumeHierarchy {
+        // Objects added by growing start with empty bounds at the origin
+        void resize(uint32_t object_count);
+        inline uint32_t size() const { return static_cast<uint32_t>(object_bounds.size()); }
+
+        // Unchanged bounds are ignored, so static objects may be set every frame
+        void set_bounds(uint32_t object, const BoundingBox& bounds);
+        inline const BoundingBox& get_bounds(uint32_t object) const { return object_bounds[object]; }
+
+        // Applies moved bounds to the tree, must run before culling
+        void refit();
+
+        // Replaces visible_objects with the objects intersecting the frustum, in parallel when
+        // given a pool
+        void cull(const Frustum& frustum, std::vector<uint32_t>& visible_objects, WorkerPool* worker_pool = nullptr);
+
+    private:
+        struct Node {
+            glm::vec3 min;
+            glm::vec3 max;
+            uint32_t  parent;
+            uint32_t  children;   // Index of the first of two adjacent children, no_node for leaves
+            uint32_t  first_slot; // Slots of every object below the node are contiguous
+            uint32_t  slot_count;
+        };
+
+        // Per object
+        std::vector<BoundingBox> object_bounds;
+        std::vector<uint32_t>    object_slots;
+        std::vector<uint32_t>    object_leaves;
+
+        // Per slot, objects in tree order
+        std::vector<float>       center_x;
+        std::vector<float>       center_y;
+        std::vector<float>       center_z;
+        std::vector<float>       extent_x;
+        std::vector<float>       extent_y;
+        std::vector<float>       extent_z;
+        std::vector<uint32_t>    slot_objects;
+
+        std::vector<Node>        nodes;
+        std::vector<uint32_t>    moved_leaves;
+        std::vector<uint8_t>     leaf_moved;
+        std::vector<uint32_t>    chunk_counts;
+        double                   surface_area  = 0.0; // Summed over all nodes, the cost of a traversal
+        double                   built_area    = 0.0;
+        bool                     layout_dirty  = false;
+
+        void rebuild();
+        void build(uint32_t node, uint32_t first_slot, uint32_t slot_count);
+        void fit_leaf(Node& node) const;
+        size_t cull_range(const Frustum& frustum, uint32_t begin, uint32_t end, uint32_t* visible_objects) const;
+    };
+
+}
@@ -1,7 +1,16 @@
 #include "file.hpp"
 
+#include <cstring>
 #include <fstream>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STIRLING_MMAP
+#endif
+
 std::vector<uint8_t> read_file(const char* file_name) {
     std::ifstream file{file_name, std::ios::ate | std::ios::binary | std::ios::in};
     if (!file.is_open()) throw "Failed to open file.";
@@ -9,6 +18,82 @@ std::vector<uint8_t> read_file(const char* file_name) {
     std::vector<uint8_t> buffer;
     buffer.resize(file_size);
     file.seekg(0, std::ios::beg);
-    file.read(reinterpret_cast<char*>(buffer.data()), file_size);
+    if (!file.read(reinterpret_cast<char*>(buffer.data()), file_size)) throw "Failed to read file.";
     return buffer;
-}
\ No newline at end of file
+}
+
+FileView::FileView(const char* file_name) {
+#ifdef STIRLING_MMAP
+    const int descriptor = open(file_name, O_RDONLY);
+    if (descriptor == -1) throw "Failed to open file.";
+
+    struct stat file_stat;
+    if (fstat(descriptor, &file_stat) == 0 && file_stat.st_size > 0) {
+        const auto mapping = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping != MAP_FAILED) {
+            view = static_cast<const uint8_t*>(mapping);
+            view_size = static_cast<size_t>(file_stat.st_size);
+            mapped = true;
+        }
+    }
+    close(descriptor);
+    if (mapped) return;
+#endif
+
+    // Buffered fallback, allocated without zero-initialization since it is overwritten anyway
+    std::ifstream file{file_name, std::ios::ate | std::ios::binary | std::ios::in};
+    if (!file.is_open()) throw "Failed to open file.";
+    view_size = static_cast<size_t>(file.tellg());
+    buffer.reset(new uint8_t[view_size]);
+    file.seekg(0, std::ios::beg);
+
+    // A file truncated since its size was taken would leave the end of the buffer uninitialized
+    if (!file.read(reinterpret_cast<char*>(buffer.get()), view_size)) throw "Failed to read file.";
+    view = buffer.get();
+}
+
+FileView::~FileView() {
+    release();
+}
+
+FileView::FileView(FileView&& rhs) :
+    view      (rhs.view),
+    view_size (rhs.view_size),
+    mapped    (rhs.mapped),
+    buffer    (std::move(rhs.buffer)) {
+
+    rhs.view = nullptr;
+    rhs.view_size = 0;
+    rhs.mapped = false;
+}
+
+FileView& FileView::operator=(FileView&& rhs) {
+    if (this == &rhs) return *this;
+    release();
+
+    view = rhs.view;
+    view_size = rhs.view_size;
+    mapped = rhs.mapped;
+    buffer = std::move(rhs.buffer);
+
+    rhs.view = nullptr;
+    rhs.view_size = 0;
+    rhs.mapped = false;
+
+    return *this;
+}
+
+void FileView::copy(void* dst, size_t offset, size_t size) const {
+    if (offset + size > view_size) throw "File view copy out of range.";
+    memcpy(dst, view + offset, size);
+}
+
+void FileView::release() {
+#ifdef STIRLING_MMAP
+    if (mapped) munmap(const_cast<uint8_t*>(view), view_size);
+#endif
+    view = nullptr;
+    view_size = 0;
+    mapped = false;
+    buffer.reset();
+}
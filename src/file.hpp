@@ -1,6 +1,36 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
-std::vector<uint8_t> read_file(const char* file_name);
\ No newline at end of file
+std::vector<uint8_t> read_file(const char* file_name);
+
+// Read-only view of a whole file. The file is memory-mapped where the platform allows it, so
+// loaders can copy straight from the page cache into their destination (usually mapped staging
+// memory) without an intermediate heap copy. Falls back to a single buffered read otherwise.
+struct FileView {
+    FileView(const char* file_name);
+    ~FileView();
+
+    FileView(const FileView&) = delete;
+    FileView(FileView&&);
+    FileView& operator=(const FileView&) = delete;
+    FileView& operator=(FileView&&);
+
+    inline const uint8_t* data() const { return view; }
+    inline size_t size() const { return view_size; }
+    inline bool is_mapped() const { return mapped; }
+
+    void copy(void* dst, size_t offset, size_t size) const;
+
+private:
+    const uint8_t*             view = nullptr;
+    size_t                     view_size = 0;
+    bool                       mapped = false;
+    std::unique_ptr<uint8_t[]> buffer;
+
+    void release();
+};
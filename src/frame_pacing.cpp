@@ -0,0 +1,108 @@
+#include "frame_pacing.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace stirling {
+
+    VkPresentModeKHR select_present_mode(
+        PresentPolicy                        policy,
+        const std::vector<VkPresentModeKHR>& available_present_modes) {
+
+        const auto is_available = [&](VkPresentModeKHR present_mode) {
+            return std::find(
+                available_present_modes.begin(),
+                available_present_modes.end(),
+                present_mode
+            ) != available_present_modes.end();
+        };
+
+        switch (policy) {
+        case PresentPolicy::low_latency:
+            if (is_available(VK_PRESENT_MODE_MAILBOX_KHR)) return VK_PRESENT_MODE_MAILBOX_KHR;
+            if (is_available(VK_PRESENT_MODE_IMMEDIATE_KHR)) return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            break;
+        case PresentPolicy::uncapped:
+            if (is_available(VK_PRESENT_MODE_IMMEDIATE_KHR)) return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            if (is_available(VK_PRESENT_MODE_MAILBOX_KHR)) return VK_PRESENT_MODE_MAILBOX_KHR;
+            break;
+        case PresentPolicy::adaptive_vsync:
+            if (is_available(VK_PRESENT_MODE_FIFO_RELAXED_KHR)) return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+            break;
+        case PresentPolicy::vsync:
+            break;
+        }
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
+    uint32_t select_image_count(
+        uint32_t                        requested_image_count,
+        const VkSurfaceCapabilitiesKHR& surface_capabilities) {
+
+        // A max image count of 0 means there is no upper limit
+        auto image_count = requested_image_count > 0
+            ? std::max(requested_image_count, surface_capabilities.minImageCount)
+            : surface_capabilities.minImageCount + 1;
+        if (surface_capabilities.maxImageCount > 0) {
+            image_count = std::min(image_count, surface_capabilities.maxImageCount);
+        }
+        return image_count;
+    }
+
+    void wait_until(
+        std::chrono::steady_clock::time_point deadline,
+        std::chrono::microseconds             spin_threshold) {
+
+        using Clock = std::chrono::steady_clock;
+
+        // Sleep for the bulk of the wait, then spin for an accurate wake up
+        if (Clock::now() < deadline - spin_threshold) {
+            std::this_thread::sleep_until(deadline - spin_threshold);
+        }
+        while (Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+
+    FrameLimiter::FrameLimiter(
+        double                    frames_per_second,
+        std::chrono::microseconds spin_threshold) :
+
+        frame_time     (frames_per_second > 0.0
+            ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frames_per_second))
+            : Clock::duration::zero()),
+        spin_threshold (spin_threshold),
+        next_frame     (Clock::now()) {
+    }
+
+    void FrameLimiter::wait() {
+        if (frame_time == Clock::duration::zero()) return;
+
+        wait_until(next_frame, spin_threshold);
+        advance(Clock::now());
+    }
+
+    bool FrameLimiter::try_begin_frame(Clock::time_point now) {
+        if (frame_time == Clock::duration::zero()) return true;
+        if (now < next_frame) return false;
+
+        advance(now);
+        return true;
+    }
+
+    void FrameLimiter::advance(Clock::time_point now) {
+        // Schedule from the deadline to avoid drift, unless a frame ran late
+        next_frame += frame_time;
+        if (next_frame < now) {
+            next_frame = now + frame_time;
+        }
+    }
+
+    void LatencyStatistics::add(std::chrono::steady_clock::duration latency) {
+        const auto milliseconds = std::chrono::duration<double, std::milli>(latency).count();
+        ++count;
+        total_milliseconds += milliseconds;
+        max_milliseconds = std::max(max_milliseconds, milliseconds);
+    }
+
+}
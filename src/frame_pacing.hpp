@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace stirling {
+
+    enum class PresentPolicy : uint32_t {
+        vsync          = 0, // FIFO, never tears, up to a queue of frames of latency
+        low_latency    = 1, // MAILBOX, never tears, the newest frame replaces queued ones, else IMMEDIATE
+        uncapped       = 2, // IMMEDIATE, tears, lowest latency
+        adaptive_vsync = 3  // FIFO_RELAXED, tears only when a frame misses its vblank
+    };
+
+    struct PresentationSettings {
+        PresentPolicy policy;
+        uint32_t      image_count;      // Swapchain images, 0 picks one more than the surface minimum
+        double        frame_rate_limit; // Frames per second paced on the CPU, 0 disables the limiter
+    };
+
+    // Picks the mode of the policy, falling back towards FIFO, which every surface supports
+    VkPresentModeKHR select_present_mode(
+        PresentPolicy                        policy,
+        const std::vector<VkPresentModeKHR>& available_present_modes);
+
+    // Clamps the requested image count to the surface limits
+    uint32_t select_image_count(
+        uint32_t                        requested_image_count,
+        const VkSurfaceCapabilitiesKHR& surface_capabilities);
+
+    // Sleeping is only accurate to the scheduler granularity, so this sleeps until the deadline is
+    // within the spin threshold and busy waits the rest
+    void wait_until(
+        std::chrono::steady_clock::time_point deadline,
+        std::chrono::microseconds             spin_threshold = std::chrono::microseconds(2000));
+
+    // Paces frames to a fixed rate, a rate of 0 lets every frame start immediately
+    struct FrameLimiter {
+        using Clock = std::chrono::steady_clock;
+
+        FrameLimiter(
+            double                    frames_per_second,
+            std::chrono::microseconds spin_threshold = std::chrono::microseconds(2000));
+
+        // Blocks until the next frame is due, frames that are already late start immediately
+        void wait();
+
+        // Starts the next frame only when it is due, for pacing several targets from one loop
+        bool try_begin_frame(Clock::time_point now = Clock::now());
+
+        inline Clock::time_point get_next_frame_time() const { return next_frame; }
+
+    private:
+        Clock::duration           frame_time;
+        std::chrono::microseconds spin_threshold;
+        Clock::time_point         next_frame;
+
+        void advance(Clock::time_point now);
+    };
+
+    // Accumulates the delay between sampling input and the device completing the frame that used it,
+    // which excludes the wait for the presentation engine to show the image
+    struct LatencyStatistics {
+        void add(std::chrono::steady_clock::duration latency);
+
+        inline uint64_t get_count() const { return count; }
+        inline double get_average_milliseconds() const { return count > 0 ? total_milliseconds / count : 0.0; }
+        inline double get_max_milliseconds() const { return max_milliseconds; }
+
+    private:
+        uint64_t count              = 0;
+        double   total_milliseconds = 0.0;
+        double   max_milliseconds   = 0.0;
+    };
+
+}
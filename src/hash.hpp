@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace stirling {
+
+    constexpr uint64_t fnv1a_offset_basis = 0xcbf29ce484222325ull;
+    constexpr uint64_t fnv1a_prime        = 0x100000001b3ull;
+
+    inline uint64_t hash_bytes(
+        const void* data,
+        size_t      size,
+        uint64_t    seed = fnv1a_offset_basis) {
+
+        auto bytes = static_cast<const uint8_t*>(data);
+        auto hash = seed;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * fnv1a_prime;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    inline uint64_t hash_value(const T& value, uint64_t seed = fnv1a_offset_basis) {
+        return hash_bytes(&value, sizeof(T), seed);
+    }
+
+}
@@ -0,0 +1,134 @@
+#include "mesh.hpp"
+#include "file.hpp"
+#include "mesh_builder.hpp"
+#include "vulkan/staging_buffer.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace stirling {
+
+    namespace {
+
+        // Index data follows vertex data, aligned for either index type
+        constexpr VkDeviceSize index_alignment = 4;
+
+    }
+
+    MeshLoader::MeshLoader(
+        const vulkan::PhysicalDevice& physical_device,
+        const vulkan::Device&         device,
+        const vulkan::CommandPool&    command_pool,
+        const vulkan::Queue&          queue) :
+
+        physical_device (physical_device),
+        device          (device),
+        command_pool    (command_pool),
+        queue           (queue),
+        fence_pool      (device.create_fence_pool()) {
+    }
+
+    Mesh MeshLoader::load(const char* file_name) const {
+        const FileView file{file_name};
+        return load(parse_mesh_file(file.data(), file.size()));
+    }
+
+    Mesh MeshLoader::load(SourceMesh&& mesh, bool optimize) const {
+        MeshBuilder builder{std::move(mesh)};
+        if (optimize) {
+            builder.optimize();
+        }
+
+        const auto data = builder.encode();
+        return load(parse_mesh_file(data.data(), data.size()));
+    }
+
+    Mesh MeshLoader::load(const MeshFile& mesh_file) const {
+        const auto vertex_data_size = mesh_file.get_vertex_data_size();
+        const auto index_data_size = mesh_file.get_index_data_size();
+        const auto index_offset = (vertex_data_size + index_alignment - 1) & ~(index_alignment - 1);
+        const auto buffer_size = index_offset + index_data_size;
+
+        // Create buffer for both vertices and indices
+        auto buffer = device.create_buffer({
+            .size         = buffer_size,
+            .usage        = VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                          | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+                          | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+            .sharing_mode = VK_SHARING_MODE_EXCLUSIVE,
+        });
+
+        // Allocate and bind device local memory for buffer
+        const auto memory_requirements = buffer.get_memory_requirements();
+        auto memory = device.allocate_memory({
+            .allocation_size   = memory_requirements.size,
+            .memory_type_index = physical_device.find_memory_type(
+                memory_requirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+            )
+        });
+        buffer.bind(memory, 0);
+
+        {
+            // Copy vertex and index tables from the file mapping straight into staging memory
+            const vulkan::StagingBuffer staging_buffer{buffer_size, physical_device, device};
+            {
+                auto mapping = staging_buffer.map();
+                mapping.copy(mesh_file.vertices, vertex_data_size);
+                mapping.copy(mesh_file.indices, index_data_size, index_offset);
+            }
+
+            // Copy staging buffer to mesh buffer
+            const auto command_buffer = command_pool.allocate_command_buffers({
+                .level                = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                .command_buffer_count = 1
+            })[0];
+
+            command_buffer
+                .begin({{
+                    .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+                }})
+                .copy_buffer(
+                    staging_buffer,
+                    buffer,
+                    {
+                        {
+                            .srcOffset = 0,
+                            .dstOffset = 0,
+                            .size      = buffer_size
+                        }
+                    }
+                )
+                .end();
+
+            // Wait for this upload only, rather than for all work on the queue
+            const auto fence = fence_pool.acquire();
+            queue.submit({
+                {{
+                    .command_buffers = {
+                        command_buffer
+                    },
+                }}
+            }, fence);
+
+            fence_pool.wait({ fence });
+            fence_pool.release(fence);
+        }
+
+        const auto& header = mesh_file.header;
+        const glm::vec3 center{header.bounds_center[0], header.bounds_center[1], header.bounds_center[2]};
+        const glm::vec3 extent{header.bounds_extent[0], header.bounds_extent[1], header.bounds_extent[2]};
+
+        return {
+            std::move(buffer),
+            std::move(memory),
+            index_offset,
+            header.index_size == sizeof(uint16_t) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32,
+            header.vertex_count,
+            header.index_count,
+            glm::scale(glm::translate(glm::mat4(1.0f), center), extent),
+            { mesh_file.lods, mesh_file.lods + header.lod_count },
+            { mesh_file.meshlets, mesh_file.meshlets + header.meshlet_count }
+        };
+    }
+
+}
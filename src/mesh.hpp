@@ -0,0 +1,63 @@
+#pragma once
+
+#include "mesh_file.hpp"
+#include "vertex_layout.hpp"
+#include "vulkan/buffer.hpp"
+#include "vulkan/command_pool.hpp"
+#include "vulkan/device.hpp"
+#include "vulkan/device_memory.hpp"
+#include "vulkan/fence_pool.hpp"
+#include "vulkan/physical_device.hpp"
+#include "vulkan/queue.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace stirling {
+
+    // 20 bytes per vertex against 44 for the unpacked float attributes
+    using MeshVertexLayout = VertexLayout<
+        MeshVertex,
+        &MeshVertex::position,
+        &MeshVertex::color,
+        &MeshVertex::normal,
+        &MeshVertex::uv>;
+
+    // Vertices and indices share one device local buffer, indices start at index_offset
+    struct Mesh {
+        vulkan::Buffer       buffer;
+        vulkan::DeviceMemory memory;
+        VkDeviceSize         index_offset;
+        VkIndexType          index_type;
+        uint32_t             vertex_count;
+        uint32_t             index_count;
+        glm::mat4            dequantization;
+        std::vector<MeshLod> lods;
+        std::vector<Meshlet> meshlets;
+    };
+
+    struct MeshLoader {
+        MeshLoader(
+            const vulkan::PhysicalDevice& physical_device,
+            const vulkan::Device&         device,
+            const vulkan::CommandPool&    command_pool,
+            const vulkan::Queue&          queue);
+
+        Mesh load(const MeshFile& mesh_file) const;
+        Mesh load(const char* file_name) const;
+
+        // Meshes built at runtime are optimized for vertex cache, overdraw and fetch before upload
+        Mesh load(SourceMesh&& mesh, bool optimize = true) const;
+
+    private:
+        const vulkan::PhysicalDevice& physical_device;
+        const vulkan::Device&         device;
+        const vulkan::CommandPool&    command_pool;
+        const vulkan::Queue&          queue;
+        mutable vulkan::FencePool     fence_pool;
+    };
+
+}
@@ -0,0 +1,647 @@
+#include "mesh_builder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+namespace stirling {
+
+    namespace {
+
+        // FIFO cache, a vertex is cached if fewer than cache_size misses happened since it was transformed
+        struct CacheSimulator {
+            CacheSimulator(size_t vertex_count, uint32_t cache_size) :
+                cache_time (vertex_count, 0),
+                cache_size (cache_size),
+                clock      (cache_size) {
+            }
+
+            // Returns the number of transformed vertices of the triangle
+            uint32_t access(const uint32_t* triangle) {
+                uint32_t misses = 0;
+                for (size_t corner = 0; corner < 3; ++corner) {
+                    if (clock - cache_time[triangle[corner]] >= cache_size) {
+                        cache_time[triangle[corner]] = ++clock;
+                        ++misses;
+                    }
+                }
+                return misses;
+            }
+
+            void flush() {
+                clock += cache_size;
+            }
+
+        private:
+            std::vector<uint32_t> cache_time;
+            uint32_t              cache_size;
+            uint32_t              clock;
+        };
+
+        // Splits the triangle order into runs the overdraw pass may reorder without losing cache reuse
+        std::vector<size_t> find_clusters(
+            const std::vector<uint32_t>& indices,
+            size_t                       vertex_count,
+            uint32_t                     cache_size,
+            float                        threshold) {
+
+            const auto triangle_count = indices.size() / 3;
+            CacheSimulator cache{vertex_count, cache_size};
+
+            // Hard boundaries where the cache order starts over, every vertex of the triangle misses
+            std::vector<size_t> hard_boundaries;
+            for (size_t triangle = 0; triangle < triangle_count; ++triangle) {
+                if (cache.access(&indices[triangle * 3]) == 3 || triangle == 0) {
+                    hard_boundaries.push_back(triangle);
+                }
+            }
+            hard_boundaries.push_back(triangle_count);
+
+            // Soft boundaries once the running ACMR of a cluster is close enough to that of its hard cluster
+            std::vector<size_t> clusters;
+            for (size_t i = 0; i + 1 < hard_boundaries.size(); ++i) {
+                const auto start = hard_boundaries[i];
+                const auto end = hard_boundaries[i + 1];
+
+                cache.flush();
+                uint32_t cluster_misses = 0;
+                for (auto triangle = start; triangle < end; ++triangle) {
+                    cluster_misses += cache.access(&indices[triangle * 3]);
+                }
+                const auto cluster_threshold = threshold * cluster_misses / (end - start);
+
+                clusters.push_back(start);
+                cache.flush();
+                uint32_t running_misses = 0;
+                uint32_t running_triangles = 0;
+                for (auto triangle = start; triangle < end; ++triangle) {
+                    running_misses += cache.access(&indices[triangle * 3]);
+                    ++running_triangles;
+
+                    if (triangle + 1 < end && static_cast<float>(running_misses) / running_triangles <= cluster_threshold) {
+                        clusters.push_back(triangle + 1);
+                        cache.flush();
+                        running_misses = 0;
+                        running_triangles = 0;
+                    }
+                }
+            }
+            clusters.push_back(triangle_count);
+
+            return clusters;
+        }
+
+        // Area weighted sum of squared distances to the planes of triangles, p'Ap + 2b'p + c
+        struct Quadric {
+            double a00, a01, a02, a11, a12, a22;
+            double b0, b1, b2;
+            double c;
+            double area;
+
+            void add_plane(const double normal[3], double distance, double weight) {
+                a00 += weight * normal[0] * normal[0];
+                a01 += weight * normal[0] * normal[1];
+                a02 += weight * normal[0] * normal[2];
+                a11 += weight * normal[1] * normal[1];
+                a12 += weight * normal[1] * normal[2];
+                a22 += weight * normal[2] * normal[2];
+                b0  += weight * normal[0] * distance;
+                b1  += weight * normal[1] * distance;
+                b2  += weight * normal[2] * distance;
+                c   += weight * distance * distance;
+                area += weight;
+            }
+
+            void add(const Quadric& rhs) {
+                a00 += rhs.a00; a01 += rhs.a01; a02 += rhs.a02;
+                a11 += rhs.a11; a12 += rhs.a12; a22 += rhs.a22;
+                b0  += rhs.b0;  b1  += rhs.b1;  b2  += rhs.b2;
+                c   += rhs.c;
+                area += rhs.area;
+            }
+
+            double evaluate(const float* position) const {
+                const double x = position[0], y = position[1], z = position[2];
+                return a00 * x * x + a11 * y * y + a22 * z * z +
+                       2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                       2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            }
+        };
+
+        // Unnormalized normal of the triangle, its length is twice the area
+        void triangle_normal(const float* a, const float* b, const float* c, double normal[3]) {
+            const double ab[3] = { double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2] };
+            const double ac[3] = { double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2] };
+            normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+            normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+            normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+        }
+
+    }
+
+    VertexCacheStatistics analyze_vertex_cache(
+        const std::vector<uint32_t>& indices,
+        size_t                       vertex_count,
+        uint32_t                     cache_size) {
+
+        CacheSimulator cache{vertex_count, cache_size};
+        uint32_t misses = 0;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            misses += cache.access(&indices[i]);
+        }
+
+        const auto triangle_count = indices.size() / 3;
+        return {
+            .transformed_vertices = misses,
+            .acmr                 = triangle_count > 0 ? static_cast<float>(misses) / triangle_count : 0.0f,
+            .atvr                 = vertex_count > 0 ? static_cast<float>(misses) / vertex_count : 0.0f
+        };
+    }
+
+    void optimize_vertex_cache(
+        std::vector<uint32_t>& indices,
+        size_t                 vertex_count,
+        uint32_t               cache_size) {
+
+        const auto triangle_count = indices.size() / 3;
+
+        // Build vertex to triangle adjacency
+        std::vector<uint32_t> live_triangles(vertex_count, 0);
+        for (const auto index : indices) {
+            ++live_triangles[index];
+        }
+
+        std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+        for (size_t vertex = 0; vertex < vertex_count; ++vertex) {
+            adjacency_offsets[vertex + 1] = adjacency_offsets[vertex] + live_triangles[vertex];
+        }
+
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            auto fill = adjacency_offsets;
+            for (size_t i = 0; i < indices.size(); ++i) {
+                adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        std::vector<uint32_t> cache_time(vertex_count, 0);
+        std::vector<bool>     emitted(triangle_count, false);
+        std::vector<uint32_t> dead_end;
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+
+        uint32_t time = cache_size + 1;
+        size_t   cursor = 0;
+
+        // Pops the most recently used vertex that still has triangles, else scans input order
+        const auto skip_dead_end = [&]() -> int64_t {
+            while (!dead_end.empty()) {
+                const auto vertex = dead_end.back();
+                dead_end.pop_back();
+                if (live_triangles[vertex] > 0) return vertex;
+            }
+            for (; cursor < vertex_count; ++cursor) {
+                if (live_triangles[cursor] > 0) return static_cast<int64_t>(cursor);
+            }
+            return -1;
+        };
+
+        auto fanning_vertex = skip_dead_end();
+        while (fanning_vertex >= 0) {
+            candidates.clear();
+
+            // Emit every remaining triangle around the fanning vertex
+            for (auto i = adjacency_offsets[fanning_vertex]; i < adjacency_offsets[fanning_vertex + 1]; ++i) {
+                const auto triangle = adjacency[i];
+                if (emitted[triangle]) continue;
+
+                for (size_t corner = 0; corner < 3; ++corner) {
+                    const auto vertex = indices[triangle * 3 + corner];
+                    output.push_back(vertex);
+                    dead_end.push_back(vertex);
+                    candidates.push_back(vertex);
+                    --live_triangles[vertex];
+                    if (time - cache_time[vertex] > cache_size) {
+                        cache_time[vertex] = time++;
+                    }
+                }
+                emitted[triangle] = true;
+            }
+
+            // Prefer the oldest candidate that stays in cache while its remaining fan is emitted
+            int64_t next_vertex = -1;
+            int64_t best_priority = -1;
+            for (const auto vertex : candidates) {
+                if (live_triangles[vertex] == 0) continue;
+
+                int64_t priority = 0;
+                if (time - cache_time[vertex] + 2 * live_triangles[vertex] <= cache_size) {
+                    priority = time - cache_time[vertex];
+                }
+                if (priority > best_priority) {
+                    best_priority = priority;
+                    next_vertex = vertex;
+                }
+            }
+
+            fanning_vertex = next_vertex >= 0 ? next_vertex : skip_dead_end();
+        }
+
+        indices = std::move(output);
+    }
+
+    void optimize_overdraw(
+        std::vector<uint32_t>&           indices,
+        const std::vector<SourceVertex>& vertices,
+        float                            threshold,
+        uint32_t                         cache_size) {
+
+        const auto triangle_count = indices.size() / 3;
+        if (triangle_count == 0) return;
+
+        const auto clusters = find_clusters(indices, vertices.size(), cache_size, threshold);
+        const auto cluster_count = clusters.size() - 1;
+
+        // Area weighted centroid and normal of every cluster
+        struct ClusterData {
+            float centroid[3];
+            float normal[3];
+            float area;
+        };
+        std::vector<ClusterData> cluster_data(cluster_count, ClusterData{});
+        float mesh_centroid[3] = {};
+        float mesh_area = 0.0f;
+
+        for (size_t cluster = 0; cluster < cluster_count; ++cluster) {
+            auto& data = cluster_data[cluster];
+            for (auto triangle = clusters[cluster]; triangle < clusters[cluster + 1]; ++triangle) {
+                const auto& a = vertices[indices[triangle * 3 + 0]].position;
+                const auto& b = vertices[indices[triangle * 3 + 1]].position;
+                const auto& c = vertices[indices[triangle * 3 + 2]].position;
+
+                const float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+                const float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+                const float normal[3] = {
+                    ab[1] * ac[2] - ab[2] * ac[1],
+                    ab[2] * ac[0] - ab[0] * ac[2],
+                    ab[0] * ac[1] - ab[1] * ac[0]
+                };
+                const auto area = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+                for (int axis = 0; axis < 3; ++axis) {
+                    data.centroid[axis] += (a[axis] + b[axis] + c[axis]) / 3.0f * area;
+                    data.normal[axis] += normal[axis];
+                }
+                data.area += area;
+            }
+
+            for (int axis = 0; axis < 3; ++axis) {
+                mesh_centroid[axis] += data.centroid[axis];
+            }
+            mesh_area += data.area;
+
+            if (data.area > 0.0f) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    data.centroid[axis] /= data.area;
+                }
+            }
+        }
+        if (mesh_area > 0.0f) {
+            for (int axis = 0; axis < 3; ++axis) {
+                mesh_centroid[axis] /= mesh_area;
+            }
+        }
+
+        // Clusters facing away from the mesh center are likely occluders, draw them first
+        std::vector<float> sort_keys(cluster_count);
+        for (size_t cluster = 0; cluster < cluster_count; ++cluster) {
+            const auto& data = cluster_data[cluster];
+            const auto length = std::sqrt(
+                data.normal[0] * data.normal[0] + data.normal[1] * data.normal[1] + data.normal[2] * data.normal[2]);
+
+            float key = 0.0f;
+            if (length > 0.0f) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    key += (data.centroid[axis] - mesh_centroid[axis]) * data.normal[axis] / length;
+                }
+            }
+            sort_keys[cluster] = key;
+        }
+
+        std::vector<size_t> order(cluster_count);
+        for (size_t cluster = 0; cluster < cluster_count; ++cluster) {
+            order[cluster] = cluster;
+        }
+        std::stable_sort(order.begin(), order.end(), [&sort_keys](size_t lhs, size_t rhs) {
+            return sort_keys[lhs] > sort_keys[rhs];
+        });
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        for (const auto cluster : order) {
+            output.insert(
+                output.end(),
+                indices.begin() + clusters[cluster] * 3,
+                indices.begin() + clusters[cluster + 1] * 3
+            );
+        }
+
+        indices = std::move(output);
+    }
+
+    void optimize_vertex_fetch(SourceMesh& mesh) {
+        constexpr auto unused = ~0u;
+
+        std::vector<uint32_t> remap(mesh.vertices.size(), unused);
+        std::vector<SourceVertex> vertices;
+        vertices.reserve(mesh.vertices.size());
+
+        const auto remap_indices = [&](std::vector<uint32_t>& indices) {
+            for (auto& index : indices) {
+                if (remap[index] == unused) {
+                    remap[index] = static_cast<uint32_t>(vertices.size());
+                    vertices.push_back(mesh.vertices[index]);
+                }
+                index = remap[index];
+            }
+        };
+
+        remap_indices(mesh.indices);
+        for (auto& lod : mesh.lods) {
+            remap_indices(lod.indices);
+        }
+
+        mesh.vertices = std::move(vertices);
+    }
+
+    float simplify(
+        std::vector<uint32_t>&           indices,
+        const std::vector<SourceVertex>& vertices,
+        size_t                           target_index_count,
+        float                            max_error) {
+
+        const auto vertex_count = vertices.size();
+        std::vector<uint8_t> locked(vertex_count, 0);
+
+        // Vertices sharing their position with another vertex lie on an attribute seam
+        std::vector<uint32_t> by_position(vertex_count);
+        std::iota(by_position.begin(), by_position.end(), 0u);
+        const auto position_less = [&vertices](uint32_t lhs, uint32_t rhs) {
+            return std::lexicographical_compare(
+                vertices[lhs].position, vertices[lhs].position + 3,
+                vertices[rhs].position, vertices[rhs].position + 3);
+        };
+        std::sort(by_position.begin(), by_position.end(), position_less);
+
+        std::vector<uint32_t> welded(vertex_count);
+        for (size_t first = 0, last = 0; first < vertex_count; first = last) {
+            last = first + 1;
+            while (last < vertex_count && !position_less(by_position[first], by_position[last])) ++last;
+            for (auto i = first; i < last; ++i) {
+                welded[by_position[i]] = by_position[first];
+                locked[by_position[i]] = last - first > 1;
+            }
+        }
+
+        // Edges of the welded surface used by other than two triangles are borders or non-manifold
+        std::vector<uint64_t> edges;
+        edges.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            for (size_t corner = 0; corner < 3; ++corner) {
+                const auto a = welded[indices[i + corner]];
+                const auto b = welded[indices[i + (corner + 1) % 3]];
+                edges.push_back(uint64_t(std::min(a, b)) << 32 | std::max(a, b));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        for (size_t first = 0, last = 0; first < edges.size(); first = last) {
+            last = first + 1;
+            while (last < edges.size() && edges[last] == edges[first]) ++last;
+            if (last - first != 2) {
+                locked[edges[first] >> 32] = 1;
+                locked[edges[first] & 0xFFFFFFFF] = 1;
+            }
+        }
+
+        // Planes of the triangles around every vertex
+        std::vector<Quadric> quadrics(vertex_count, Quadric{});
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            const auto& a = vertices[indices[i + 0]].position;
+            double normal[3];
+            triangle_normal(a, vertices[indices[i + 1]].position, vertices[indices[i + 2]].position, normal);
+
+            const auto length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            if (length == 0.0) continue;
+            for (auto& component : normal) {
+                component /= length;
+            }
+
+            const auto distance = -(normal[0] * a[0] + normal[1] * a[1] + normal[2] * a[2]);
+            for (size_t corner = 0; corner < 3; ++corner) {
+                quadrics[indices[i + corner]].add_plane(normal, distance, length * 0.5);
+            }
+        }
+
+        // Mean squared distance of the collapsed vertex to the planes of both vertices
+        const auto collapse_error = [&](uint32_t source, uint32_t target) {
+            const auto& q0 = quadrics[source];
+            const auto& q1 = quadrics[target];
+            const auto area = q0.area + q1.area;
+            const auto& position = vertices[target].position;
+            return area > 0.0 ? std::max(0.0, q0.evaluate(position) + q1.evaluate(position)) / area : 0.0;
+        };
+
+        struct Collapse {
+            uint32_t source;
+            uint32_t target;
+            double   error;
+        };
+
+        const auto max_error_squared = double(max_error) * max_error;
+        const auto target_triangle_count = target_index_count / 3;
+        double applied_error = 0.0;
+
+        std::vector<uint32_t> remap(vertex_count);
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::vector<uint8_t> touched(vertex_count);
+        std::vector<uint32_t> triangle_offsets(vertex_count + 1);
+        std::vector<uint32_t> vertex_triangles;
+        std::vector<Collapse> collapses;
+        std::vector<uint32_t> source_ring;
+        std::vector<uint32_t> target_ring;
+
+        // Distinct neighbours of the vertex, other than the excluded one
+        const auto collect_ring = [&](uint32_t vertex, uint32_t excluded, std::vector<uint32_t>& ring) {
+            ring.clear();
+            for (auto i = triangle_offsets[vertex]; i < triangle_offsets[vertex + 1]; ++i) {
+                for (size_t corner = 0; corner < 3; ++corner) {
+                    const auto neighbour = indices[vertex_triangles[i] * 3 + corner];
+                    if (neighbour != vertex && neighbour != excluded) ring.push_back(neighbour);
+                }
+            }
+            std::sort(ring.begin(), ring.end());
+            ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+        };
+
+        while (indices.size() > target_index_count) {
+            const auto triangle_count = indices.size() / 3;
+
+            // Triangles around every vertex
+            std::fill(triangle_offsets.begin(), triangle_offsets.end(), 0);
+            for (const auto index : indices) {
+                ++triangle_offsets[index + 1];
+            }
+            std::partial_sum(triangle_offsets.begin(), triangle_offsets.end(), triangle_offsets.begin());
+            vertex_triangles.resize(indices.size());
+            {
+                auto fill = triangle_offsets;
+                for (size_t i = 0; i < indices.size(); ++i) {
+                    vertex_triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+
+            // Both directions of every edge leaving an unlocked vertex, cheapest first
+            collapses.clear();
+            for (size_t i = 0; i < indices.size(); ++i) {
+                const auto a = indices[i];
+                const auto b = indices[i % 3 == 2 ? i - 2 : i + 1];
+                if (!locked[a]) collapses.push_back({a, b, collapse_error(a, b)});
+                if (!locked[b]) collapses.push_back({b, a, collapse_error(b, a)});
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs) {
+                return lhs.error < rhs.error;
+            });
+
+            // Collapses of one pass must not share triangles, so each is checked against final positions
+            std::fill(touched.begin(), touched.end(), 0);
+            auto remaining_triangles = triangle_count;
+            size_t applied = 0;
+            for (const auto& collapse : collapses) {
+                if (collapse.error > max_error_squared || remaining_triangles <= target_triangle_count) break;
+                if (touched[collapse.source] || touched[collapse.target]) continue;
+
+                const auto begin = vertex_triangles.begin() + triangle_offsets[collapse.source];
+                const auto end = vertex_triangles.begin() + triangle_offsets[collapse.source + 1];
+
+                // Reject collapses that flip or sharply turn a remaining triangle
+                bool valid = true;
+                uint32_t removed = 0;
+                for (auto it = begin; it != end && valid; ++it) {
+                    const auto triangle = &indices[*it * 3];
+                    if (triangle[0] == collapse.target || triangle[1] == collapse.target || triangle[2] == collapse.target) {
+                        ++removed;
+                        continue;
+                    }
+
+                    const float* before[3];
+                    const float* after[3];
+                    for (size_t corner = 0; corner < 3; ++corner) {
+                        before[corner] = vertices[triangle[corner]].position;
+                        after[corner] = triangle[corner] == collapse.source ? vertices[collapse.target].position : before[corner];
+                    }
+
+                    double normal_before[3];
+                    double normal_after[3];
+                    triangle_normal(before[0], before[1], before[2], normal_before);
+                    triangle_normal(after[0], after[1], after[2], normal_after);
+                    // Normals turning by more than about 75 degrees add up to flips over several collapses
+                    const auto dot = normal_before[0] * normal_after[0] + normal_before[1] * normal_after[1] + normal_before[2] * normal_after[2];
+                    const auto length_before = std::sqrt(normal_before[0] * normal_before[0] + normal_before[1] * normal_before[1] + normal_before[2] * normal_before[2]);
+                    const auto length_after = std::sqrt(normal_after[0] * normal_after[0] + normal_after[1] * normal_after[1] + normal_after[2] * normal_after[2]);
+                    valid = dot > 0.25 * length_before * length_after;
+                }
+                if (!valid || removed == 0) continue;
+
+                // Endpoints sharing neighbours beyond the vertices opposite the edge would pinch the surface
+                collect_ring(collapse.source, collapse.target, source_ring);
+                collect_ring(collapse.target, collapse.source, target_ring);
+                uint32_t shared = 0;
+                for (const auto vertex : target_ring) {
+                    shared += std::binary_search(source_ring.begin(), source_ring.end(), vertex);
+                }
+                if (shared > removed) continue;
+
+                remap[collapse.source] = collapse.target;
+                quadrics[collapse.target].add(quadrics[collapse.source]);
+                applied_error = std::max(applied_error, collapse.error);
+                remaining_triangles -= removed;
+                ++applied;
+
+                touched[collapse.target] = 1;
+                for (auto it = begin; it != end; ++it) {
+                    for (size_t corner = 0; corner < 3; ++corner) {
+                        touched[indices[*it * 3 + corner]] = 1;
+                    }
+                }
+            }
+            if (applied == 0) break;
+
+            // Drop triangles collapsed to lines
+            size_t output = 0;
+            for (size_t i = 0; i < indices.size(); i += 3) {
+                const auto a = remap[indices[i + 0]];
+                const auto b = remap[indices[i + 1]];
+                const auto c = remap[indices[i + 2]];
+                if (a != b && b != c && c != a) {
+                    indices[output++] = a;
+                    indices[output++] = b;
+                    indices[output++] = c;
+                }
+            }
+            indices.resize(output);
+        }
+
+        return static_cast<float>(std::sqrt(applied_error));
+    }
+
+    MeshBuilder::MeshBuilder(SourceMesh&& mesh) :
+        mesh (std::move(mesh)) {
+    }
+
+    VertexCacheStatistics MeshBuilder::get_statistics() const {
+        return analyze_vertex_cache(mesh.indices, mesh.vertices.size());
+    }
+
+    void MeshBuilder::build_lods(uint32_t max_lod_count, float reduction) {
+        // Levels that keep most triangles, e.g. where borders are locked, are not worth their memory
+        constexpr float min_reduction = 0.85f;
+
+        mesh.lods.clear();
+        auto previous_index_count = mesh.indices.size();
+        float error = 0.0f;
+        while (mesh.lods.size() + 1 < max_lod_count) {
+            // Every level starts from the full mesh, so its error is measured against the full surface
+            auto indices = mesh.indices;
+            const auto target_index_count = static_cast<size_t>(previous_index_count / 3 * reduction) * 3;
+            const auto lod_error = simplify(indices, mesh.vertices, target_index_count);
+            if (indices.size() > previous_index_count * min_reduction) break;
+
+            error = std::max(error, lod_error);
+            previous_index_count = indices.size();
+            mesh.lods.push_back({std::move(indices), error});
+        }
+    }
+
+    void MeshBuilder::optimize(float overdraw_threshold) {
+        // Cache order first, overdraw only moves whole clusters of it, the fetch remap then follows
+        // the final triangle order
+        optimize_vertex_cache(mesh.indices, mesh.vertices.size());
+        optimize_overdraw(mesh.indices, mesh.vertices, overdraw_threshold);
+        for (auto& lod : mesh.lods) {
+            optimize_vertex_cache(lod.indices, mesh.vertices.size());
+            optimize_overdraw(lod.indices, mesh.vertices, overdraw_threshold);
+        }
+        optimize_vertex_fetch(mesh);
+    }
+
+    std::vector<uint8_t> MeshBuilder::encode() const {
+        return encode_mesh_file(mesh);
+    }
+
+    void MeshBuilder::write(const char* file_name) const {
+        write_mesh_file(file_name, mesh);
+    }
+
+}
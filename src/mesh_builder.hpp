@@ -0,0 +1,77 @@
+#pragma once
+
+#include "mesh_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace stirling {
+
+    // FIFO post-transform cache size assumed by the optimizer and the statistics
+    constexpr uint32_t vertex_cache_size = 16;
+
+    struct VertexCacheStatistics {
+        uint32_t transformed_vertices;
+        float    acmr; // Average cache miss ratio, transformed vertices per triangle
+        float    atvr; // Average transformed vertex ratio, transformed vertices per vertex
+    };
+
+    // Simulates a FIFO post-transform cache over the index order
+    VertexCacheStatistics analyze_vertex_cache(
+        const std::vector<uint32_t>& indices,
+        size_t                       vertex_count,
+        uint32_t                     cache_size = vertex_cache_size);
+
+    // Reorders triangles for post-transform cache reuse (Tipsify, Sander et al. 2007)
+    void optimize_vertex_cache(
+        std::vector<uint32_t>& indices,
+        size_t                 vertex_count,
+        uint32_t               cache_size = vertex_cache_size);
+
+    // Reorders clusters of the cache optimized order front to back from the outside in, clusters
+    // are split where their ACMR stays within threshold of the unsplit order
+    void optimize_overdraw(
+        std::vector<uint32_t>&           indices,
+        const std::vector<SourceVertex>& vertices,
+        float                            threshold  = 1.05f,
+        uint32_t                         cache_size = vertex_cache_size);
+
+    // Reorders vertices by first use in the index order of the levels, from fine to coarse, and drops
+    // unreferenced vertices
+    void optimize_vertex_fetch(SourceMesh& mesh);
+
+    // Collapses edges onto neighbouring vertices in order of quadric error (Garland and Heckbert
+    // 1997) until at most target_index_count indices remain or the next collapse would exceed
+    // max_error. Vertices on borders and attribute seams stay in place, so the result indexes the
+    // same vertices. Returns the largest error of an applied collapse, in units of the positions.
+    float simplify(
+        std::vector<uint32_t>&           indices,
+        const std::vector<SourceVertex>& vertices,
+        size_t                           target_index_count,
+        float                            max_error = std::numeric_limits<float>::max());
+
+    struct MeshBuilder {
+        explicit MeshBuilder(SourceMesh&& mesh);
+
+        inline const SourceMesh& get_mesh() const { return mesh; }
+        inline uint32_t get_index_size() const { return select_index_size(mesh.vertices.size()); }
+
+        VertexCacheStatistics get_statistics() const;
+
+        // Adds levels of detail with about reduction times the triangles of the previous level, until
+        // there are max_lod_count levels or simplification stops making progress
+        void build_lods(uint32_t max_lod_count = mesh_max_lods, float reduction = 0.5f);
+
+        // Optimizes the indices of every level of detail
+        void optimize(float overdraw_threshold = 1.05f);
+
+        std::vector<uint8_t> encode() const;
+        void write(const char* file_name) const;
+
+    private:
+        SourceMesh mesh;
+    };
+
+}
@@ -0,0 +1,253 @@
+#include "mesh_file.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace stirling {
+
+    namespace {
+
+        constexpr uint64_t mesh_alignment = 16;
+
+        inline uint64_t align(uint64_t offset) {
+            return (offset + mesh_alignment - 1) & ~(mesh_alignment - 1);
+        }
+
+        // Greedily splits triangles, in index order, into meshlets bounded by vertex and triangle count.
+        // Meshlets are appended, their index offsets start at first_index of the index table.
+        void build_meshlets(
+            const std::vector<SourceVertex>& vertices,
+            const std::vector<uint32_t>&     indices,
+            uint32_t                         first_index,
+            std::vector<Meshlet>&            meshlets) {
+
+            const auto first_meshlet = meshlets.size();
+            std::vector<uint32_t> meshlet_stamp(vertices.size(), ~0u);
+            std::vector<uint32_t> meshlet_vertices;
+            meshlet_vertices.reserve(meshlet_max_vertices);
+
+            const auto close_meshlet = [&](uint32_t index_end) {
+                const auto index_offset = meshlets.size() == first_meshlet ? first_index : meshlets.back().index_offset + meshlets.back().index_count;
+
+                // Bounding sphere around the box of the meshlet vertices
+                float min[3] = { INFINITY, INFINITY, INFINITY };
+                float max[3] = { -INFINITY, -INFINITY, -INFINITY };
+                for (const auto vertex : meshlet_vertices) {
+                    for (int axis = 0; axis < 3; ++axis) {
+                        min[axis] = std::min(min[axis], vertices[vertex].position[axis]);
+                        max[axis] = std::max(max[axis], vertices[vertex].position[axis]);
+                    }
+                }
+
+                Meshlet meshlet {
+                    .index_offset = index_offset,
+                    .index_count  = index_end - index_offset,
+                    .center       = {
+                        (min[0] + max[0]) * 0.5f,
+                        (min[1] + max[1]) * 0.5f,
+                        (min[2] + max[2]) * 0.5f
+                    }
+                };
+                float radius_squared = 0.0f;
+                for (const auto vertex : meshlet_vertices) {
+                    float distance_squared = 0.0f;
+                    for (int axis = 0; axis < 3; ++axis) {
+                        const auto delta = vertices[vertex].position[axis] - meshlet.center[axis];
+                        distance_squared += delta * delta;
+                    }
+                    radius_squared = std::max(radius_squared, distance_squared);
+                }
+                meshlet.radius = std::sqrt(radius_squared);
+
+                meshlets.push_back(meshlet);
+                meshlet_vertices.clear();
+            };
+
+            uint32_t triangle_count = 0;
+            for (uint32_t i = 0; i < indices.size(); i += 3) {
+                const auto meshlet_index = static_cast<uint32_t>(meshlets.size());
+                uint32_t new_vertices = 0;
+                for (uint32_t j = 0; j < 3; ++j) {
+                    if (meshlet_stamp[indices[i + j]] != meshlet_index) ++new_vertices;
+                }
+
+                if (meshlet_vertices.size() + new_vertices > meshlet_max_vertices || triangle_count == meshlet_max_triangles) {
+                    close_meshlet(first_index + i);
+                    triangle_count = 0;
+                }
+
+                const auto current_meshlet = static_cast<uint32_t>(meshlets.size());
+                for (uint32_t j = 0; j < 3; ++j) {
+                    const auto vertex = indices[i + j];
+                    if (meshlet_stamp[vertex] != current_meshlet) {
+                        meshlet_stamp[vertex] = current_meshlet;
+                        meshlet_vertices.push_back(vertex);
+                    }
+                }
+                ++triangle_count;
+            }
+            if (triangle_count > 0) {
+                close_meshlet(first_index + static_cast<uint32_t>(indices.size()));
+            }
+        }
+
+    }
+
+    MeshFile parse_mesh_file(const uint8_t* data, size_t size) {
+        if (size < sizeof(MeshHeader)) throw "Malformed mesh file.";
+
+        MeshFile mesh_file;
+        memcpy(&mesh_file.header, data, sizeof(MeshHeader));
+
+        const auto& header = mesh_file.header;
+        if (memcmp(header.magic, mesh_magic, sizeof(mesh_magic)) != 0) throw "Not a mesh file.";
+        if (header.version != mesh_version) throw "Unsupported mesh file version.";
+        if (header.index_size != 2 && header.index_size != 4) throw "Malformed mesh file.";
+
+        const auto check_range = [size](uint64_t offset, uint64_t range_size) {
+            if (offset % mesh_alignment != 0 || offset > size || range_size > size - offset) throw "Malformed mesh file.";
+        };
+        check_range(header.vertex_offset, mesh_file.get_vertex_data_size());
+        check_range(header.index_offset, mesh_file.get_index_data_size());
+        check_range(header.meshlet_offset, uint64_t(header.meshlet_count) * sizeof(Meshlet));
+        check_range(header.lod_offset, uint64_t(header.lod_count) * sizeof(MeshLod));
+
+        // Every mesh has at least its full detail level, and each level must lie within the tables
+        if (header.lod_count == 0 || header.lod_count > mesh_max_lods) throw "Malformed mesh file.";
+        for (uint32_t i = 0; i < header.lod_count; ++i) {
+            MeshLod lod;
+            memcpy(&lod, data + header.lod_offset + i * sizeof(MeshLod), sizeof(MeshLod));
+            if (uint64_t(lod.index_offset) + lod.index_count > header.index_count ||
+                uint64_t(lod.meshlet_offset) + lod.meshlet_count > header.meshlet_count) {
+                throw "Malformed mesh file.";
+            }
+        }
+
+        // Tables are used in place, nothing is copied until the upload into staging memory
+        mesh_file.vertices = reinterpret_cast<const MeshVertex*>(data + header.vertex_offset);
+        mesh_file.indices  = data + header.index_offset;
+        mesh_file.meshlets = reinterpret_cast<const Meshlet*>(data + header.meshlet_offset);
+        mesh_file.lods     = reinterpret_cast<const MeshLod*>(data + header.lod_offset);
+        return mesh_file;
+    }
+
+    std::vector<uint8_t> encode_mesh_file(const SourceMesh& mesh) {
+        if (mesh.vertices.empty() || mesh.indices.empty() || mesh.indices.size() % 3 != 0) {
+            throw "Mesh must contain whole triangles.";
+        }
+        if (mesh.lods.size() + 1 > mesh_max_lods) throw "Mesh has too many levels of detail.";
+        for (const auto& lod : mesh.lods) {
+            if (lod.indices.empty() || lod.indices.size() % 3 != 0) throw "Mesh must contain whole triangles.";
+        }
+
+        // Find bounds used as the quantization range of positions
+        float min[3] = { INFINITY, INFINITY, INFINITY };
+        float max[3] = { -INFINITY, -INFINITY, -INFINITY };
+        for (const auto& vertex : mesh.vertices) {
+            for (int axis = 0; axis < 3; ++axis) {
+                min[axis] = std::min(min[axis], vertex.position[axis]);
+                max[axis] = std::max(max[axis], vertex.position[axis]);
+            }
+        }
+
+        MeshHeader header {
+            .version      = mesh_version,
+            .vertex_count = static_cast<uint32_t>(mesh.vertices.size()),
+            .index_size   = select_index_size(mesh.vertices.size()),
+            .lod_count    = static_cast<uint32_t>(mesh.lods.size() + 1)
+        };
+        memcpy(header.magic, mesh_magic, sizeof(mesh_magic));
+        for (int axis = 0; axis < 3; ++axis) {
+            header.bounds_center[axis] = (min[axis] + max[axis]) * 0.5f;
+            header.bounds_extent[axis] = max[axis] > min[axis] ? (max[axis] - min[axis]) * 0.5f : 1.0f;
+        }
+
+        // Quantize vertices
+        std::vector<MeshVertex> vertices;
+        vertices.reserve(mesh.vertices.size());
+        for (const auto& vertex : mesh.vertices) {
+            vertices.push_back({
+                .position = {{
+                    pack_snorm16((vertex.position[0] - header.bounds_center[0]) / header.bounds_extent[0]),
+                    pack_snorm16((vertex.position[1] - header.bounds_center[1]) / header.bounds_extent[1]),
+                    pack_snorm16((vertex.position[2] - header.bounds_center[2]) / header.bounds_extent[2]),
+                    32767
+                }},
+                .normal   = pack_octahedral(vertex.normal),
+                .color    = {{
+                    pack_unorm8(vertex.color[0]),
+                    pack_unorm8(vertex.color[1]),
+                    pack_unorm8(vertex.color[2]),
+                    255
+                }},
+                .uv       = {{
+                    pack_half(vertex.uv[0]),
+                    pack_half(vertex.uv[1])
+                }}
+            });
+        }
+
+        // Every level gets its own index range and meshlets
+        std::vector<uint32_t> indices;
+        std::vector<Meshlet> meshlets;
+        std::vector<MeshLod> lods;
+        const auto add_lod = [&](const std::vector<uint32_t>& lod_indices, float error) {
+            const auto index_offset = static_cast<uint32_t>(indices.size());
+            const auto meshlet_offset = static_cast<uint32_t>(meshlets.size());
+            build_meshlets(mesh.vertices, lod_indices, index_offset, meshlets);
+            indices.insert(indices.end(), lod_indices.begin(), lod_indices.end());
+
+            lods.push_back({
+                .index_offset   = index_offset,
+                .index_count    = static_cast<uint32_t>(lod_indices.size()),
+                .meshlet_offset = meshlet_offset,
+                .meshlet_count  = static_cast<uint32_t>(meshlets.size()) - meshlet_offset,
+                .error          = error
+            });
+        };
+
+        add_lod(mesh.indices, 0.0f);
+        for (const auto& lod : mesh.lods) {
+            add_lod(lod.indices, lod.error);
+        }
+        header.index_count = static_cast<uint32_t>(indices.size());
+        header.meshlet_count = static_cast<uint32_t>(meshlets.size());
+
+        // Lay out tables
+        header.vertex_offset  = align(sizeof(MeshHeader));
+        header.index_offset   = align(header.vertex_offset + vertices.size() * sizeof(MeshVertex));
+        header.meshlet_offset = align(header.index_offset + indices.size() * header.index_size);
+        header.lod_offset     = align(header.meshlet_offset + meshlets.size() * sizeof(Meshlet));
+
+        std::vector<uint8_t> data(header.lod_offset + lods.size() * sizeof(MeshLod));
+        const auto write_at = [&data](uint64_t offset, const void* src, size_t size) {
+            memcpy(data.data() + offset, src, size);
+        };
+
+        write_at(0, &header, sizeof(header));
+        write_at(header.vertex_offset, vertices.data(), vertices.size() * sizeof(MeshVertex));
+        if (header.index_size == sizeof(uint16_t)) {
+            auto short_indices = reinterpret_cast<uint16_t*>(data.data() + header.index_offset);
+            std::copy(indices.begin(), indices.end(), short_indices);
+        } else {
+            write_at(header.index_offset, indices.data(), indices.size() * sizeof(uint32_t));
+        }
+        write_at(header.meshlet_offset, meshlets.data(), meshlets.size() * sizeof(Meshlet));
+        write_at(header.lod_offset, lods.data(), lods.size() * sizeof(MeshLod));
+
+        return data;
+    }
+
+    void write_mesh_file(const char* file_name, const SourceMesh& mesh) {
+        const auto data = encode_mesh_file(mesh);
+
+        std::ofstream file{file_name, std::ios::binary | std::ios::out | std::ios::trunc};
+        if (!file.is_open()) throw "Failed to open file.";
+
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!file) throw "Failed to write mesh file.";
+    }
+
+}
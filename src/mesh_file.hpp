@@ -0,0 +1,108 @@
+#pragma once
+
+#include "vertex_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stirling {
+
+    // Vertex as stored on disk and consumed by the GPU. Positions are snorm16 relative to the
+    // mesh bounds, so the dequantization is folded into the model matrix instead of the shader.
+    struct MeshVertex {
+        snorm16x4  position;
+        octahedral normal;
+        unorm8x4   color;
+        half2      uv;
+    };
+    static_assert(sizeof(MeshVertex) == 20, "Mesh vertex must be tightly packed.");
+
+    struct Meshlet {
+        uint32_t index_offset;
+        uint32_t index_count;
+        float    center[3];
+        float    radius;
+    };
+
+    struct MeshLod {
+        uint32_t index_offset;
+        uint32_t index_count;
+        uint32_t meshlet_offset;
+        uint32_t meshlet_count;
+        float    error;
+        uint32_t reserved;
+    };
+
+    // On-disk layout: header followed by 16 byte aligned vertex, index, meshlet and LOD tables.
+    // Index ranges of every LOD live in the same index table.
+    struct MeshHeader {
+        uint8_t  magic[4];
+        uint32_t version;
+        uint32_t vertex_count;
+        uint32_t index_count;
+        uint32_t index_size;
+        uint32_t meshlet_count;
+        uint32_t lod_count;
+        uint32_t reserved;
+        float    bounds_center[3];
+        float    bounds_extent[3];
+        uint64_t vertex_offset;
+        uint64_t index_offset;
+        uint64_t meshlet_offset;
+        uint64_t lod_offset;
+    };
+
+    constexpr uint8_t  mesh_magic[4]         = { 'S', 'T', 'M', 'S' };
+    constexpr uint32_t mesh_version          = 2;
+    constexpr uint32_t meshlet_max_vertices  = 64;
+    constexpr uint32_t meshlet_max_triangles = 124;
+    constexpr uint32_t mesh_max_lods         = 8;
+
+    // 16 bit indices halve index fetch bandwidth whenever every vertex is addressable with them
+    inline uint32_t select_index_size(size_t vertex_count) {
+        return vertex_count <= UINT16_MAX + size_t(1) ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
+
+    // Non-owning view of a mesh file held in memory, usually a file or archive mapping
+    struct MeshFile {
+        MeshHeader        header;
+        const MeshVertex* vertices;
+        const void*       indices;
+        const Meshlet*    meshlets;
+        const MeshLod*    lods;
+
+        // Computed in 64 bits, so sizes of malformed headers cannot wrap around
+        inline uint64_t get_vertex_data_size() const { return uint64_t(header.vertex_count) * sizeof(MeshVertex); }
+        inline uint64_t get_index_data_size() const { return uint64_t(header.index_count) * header.index_size; }
+    };
+
+    MeshFile parse_mesh_file(const uint8_t* data, size_t size);
+
+    // Unquantized mesh as produced by importers
+    struct SourceVertex {
+        float position[3];
+        float normal[3];
+        float color[3];
+        float uv[2];
+    };
+
+    // Coarser index list over the vertices of the full mesh. The error is how far the surface
+    // deviates from the full mesh, in units of the vertex positions.
+    struct SourceLod {
+        std::vector<uint32_t> indices;
+        float                 error;
+    };
+
+    struct SourceMesh {
+        std::vector<SourceVertex> vertices;
+        std::vector<uint32_t>     indices;
+        std::vector<SourceLod>    lods; // From fine to coarse, indices are the first level
+    };
+
+    // Quantizes the mesh and lays it out exactly as it is stored on disk, the indices of every level
+    // follow each other in one table
+    std::vector<uint8_t> encode_mesh_file(const SourceMesh& mesh);
+    void write_mesh_file(const char* file_name, const SourceMesh& mesh);
+
+}
@@ -0,0 +1,164 @@
+#include "render_queue.hpp"
+
+namespace stirling {
+
+    uint64_t make_sort_key(
+        uint32_t pass,
+        uint32_t pipeline,
+        uint32_t material,
+        float    depth,
+        bool     back_to_front) {
+
+        // Bit patterns of non-negative floats order like the floats themselves, the comparison also
+        // maps NaN and negative zero to positive zero
+        uint32_t depth_bits;
+        depth = depth > 0.0f ? depth : 0.0f;
+        memcpy(&depth_bits, &depth, sizeof(depth_bits));
+        if (back_to_front) {
+            depth_bits = ~depth_bits;
+        }
+
+        constexpr uint32_t material_shift = sort_key_depth_bits;
+        constexpr uint32_t pipeline_shift = material_shift + sort_key_material_bits;
+        constexpr uint32_t pass_shift     = pipeline_shift + sort_key_pipeline_bits;
+
+        return (static_cast<uint64_t>(pass & ((1u << sort_key_pass_bits) - 1)) << pass_shift) |
+               (static_cast<uint64_t>(pipeline & ((1u << sort_key_pipeline_bits) - 1)) << pipeline_shift) |
+               (static_cast<uint64_t>(material & ((1u << sort_key_material_bits) - 1)) << material_shift) |
+               depth_bits;
+    }
+
+    void RenderQueue::push(uint64_t sort_key, const DrawPacket& packet) {
+        entries.push_back({sort_key, static_cast<uint32_t>(draws.size())});
+        draws.push_back({
+            .packet          = packet,
+            .constant_stages = 0,
+            .constant_offset = 0,
+            .constant_size   = 0
+        });
+    }
+
+    void RenderQueue::sort() {
+        constexpr uint32_t digit_count = sizeof(uint64_t);
+        const auto entry_count = entries.size();
+        if (entry_count < 2) return;
+
+        // Histogram every digit in a single pass over the keys
+        uint32_t counts[digit_count][256] = {};
+        for (const auto& entry : entries) {
+            for (uint32_t digit = 0; digit < digit_count; ++digit) {
+                ++counts[digit][(entry.key >> (digit * 8)) & 0xFF];
+            }
+        }
+
+        // Stable scatter by each digit from least significant, skipping digits shared by every key
+        scratch.resize(entry_count);
+        for (uint32_t digit = 0; digit < digit_count; ++digit) {
+            auto& digit_counts = counts[digit];
+            const auto shift = digit * 8;
+            if (digit_counts[(entries[0].key >> shift) & 0xFF] == entry_count) continue;
+
+            uint32_t offset = 0;
+            for (auto& count : digit_counts) {
+                const auto bucket_count = count;
+                count = offset;
+                offset += bucket_count;
+            }
+
+            for (const auto& entry : entries) {
+                scratch[digit_counts[(entry.key >> shift) & 0xFF]++] = entry;
+            }
+            entries.swap(scratch);
+        }
+    }
+
+    void RenderQueue::record(const vulkan::CommandBuffer& command_buffer) {
+        sort();
+
+        VkPipeline       pipeline        = VK_NULL_HANDLE;
+        VkPipelineLayout pipeline_layout = VK_NULL_HANDLE;
+        VkDescriptorSet  descriptor_set  = VK_NULL_HANDLE;
+        VkBuffer         vertex_buffer   = VK_NULL_HANDLE;
+        VkBuffer         index_buffer    = VK_NULL_HANDLE;
+        VkDeviceSize     index_offset    = 0;
+        VkIndexType      index_type      = VK_INDEX_TYPE_UINT16;
+
+        for (const auto& entry : entries) {
+            const auto& draw = draws[entry.draw];
+            const auto& packet = draw.packet;
+
+            if (packet.pipeline != pipeline) {
+                command_buffer.bind_pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, packet.pipeline);
+                pipeline = packet.pipeline;
+                ++statistics.pipeline_binds;
+            } else {
+                ++statistics.pipeline_binds_skipped;
+            }
+
+            // Bound sets only stay valid across pipelines with the same layout
+            if (packet.pipeline_layout != pipeline_layout) {
+                pipeline_layout = packet.pipeline_layout;
+                descriptor_set = VK_NULL_HANDLE;
+            }
+
+            if (packet.descriptor_set != VK_NULL_HANDLE) {
+                if (packet.descriptor_set != descriptor_set) {
+                    command_buffer.bind_descriptor_sets(
+                        VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 0, { packet.descriptor_set }, {});
+                    descriptor_set = packet.descriptor_set;
+                    ++statistics.descriptor_set_binds;
+                } else {
+                    ++statistics.descriptor_set_binds_skipped;
+                }
+            }
+
+            if (packet.vertex_buffer != vertex_buffer) {
+                command_buffer.bind_vertex_buffers(0, { packet.vertex_buffer }, { 0 });
+                vertex_buffer = packet.vertex_buffer;
+                ++statistics.vertex_buffer_binds;
+            } else {
+                ++statistics.vertex_buffer_binds_skipped;
+            }
+
+            if (packet.index_buffer != index_buffer ||
+                packet.index_offset != index_offset ||
+                packet.index_type != index_type) {
+                command_buffer.bind_index_buffer(packet.index_buffer, packet.index_offset, packet.index_type);
+                index_buffer = packet.index_buffer;
+                index_offset = packet.index_offset;
+                index_type = packet.index_type;
+                ++statistics.index_buffer_binds;
+            } else {
+                ++statistics.index_buffer_binds_skipped;
+            }
+
+            if (draw.constant_size > 0) {
+                command_buffer.push_constants(
+                    pipeline_layout,
+                    draw.constant_stages,
+                    0,
+                    draw.constant_size,
+                    constant_data.data() + draw.constant_offset
+                );
+            }
+
+            if (packet.query_pool != VK_NULL_HANDLE) {
+                command_buffer.begin_query(packet.query_pool, packet.query, 0);
+            }
+
+            command_buffer.draw_indexed(packet.index_count, 1, packet.first_index, packet.vertex_offset, 0);
+            ++statistics.draws;
+
+            if (packet.query_pool != VK_NULL_HANDLE) {
+                command_buffer.end_query(packet.query_pool, packet.query);
+            }
+        }
+    }
+
+    void RenderQueue::clear() {
+        draws.clear();
+        entries.clear();
+        constant_data.clear();
+    }
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "vulkan/command_buffer.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace stirling {
+
+    // Sort key bit widths, from the most significant bits: pass, pipeline, material and depth, so
+    // sorted draws change the most expensive state least often
+    constexpr uint32_t sort_key_pass_bits     = 4;
+    constexpr uint32_t sort_key_pipeline_bits = 12;
+    constexpr uint32_t sort_key_material_bits = 16;
+    constexpr uint32_t sort_key_depth_bits    = 32;
+
+    // Builds a sort key, opaque passes draw front to back and blended passes back to front
+    uint64_t make_sort_key(
+        uint32_t pass,
+        uint32_t pipeline,
+        uint32_t material,
+        float    depth,
+        bool     back_to_front = false);
+
+    // State and arguments of one indexed draw. The descriptor set is bound as set 0, draws with a
+    // query pool are wrapped in a query on it.
+    struct DrawPacket {
+        VkPipeline       pipeline;
+        VkPipelineLayout pipeline_layout;
+        VkDescriptorSet  descriptor_set;
+        VkBuffer         vertex_buffer;
+        VkBuffer         index_buffer;
+        VkDeviceSize     index_offset;
+        VkIndexType      index_type;
+        uint32_t         index_count;
+        uint32_t         first_index;
+        int32_t          vertex_offset;
+        VkQueryPool      query_pool;
+        uint32_t         query;
+    };
+
+    struct RenderQueueStatistics {
+        uint64_t draws;
+        uint64_t pipeline_binds;
+        uint64_t pipeline_binds_skipped;
+        uint64_t descriptor_set_binds;
+        uint64_t descriptor_set_binds_skipped;
+        uint64_t vertex_buffer_binds;
+        uint64_t vertex_buffer_binds_skipped;
+        uint64_t index_buffer_binds;
+        uint64_t index_buffer_binds_skipped;
+    };
+
+    // Collects the draws of a frame, radix sorts them by key and records only the state that
+    // differs from the previous draw. Storage is kept across clears, so steady state frames do
+    // not allocate.
+    struct RenderQueue {
+        void push(uint64_t sort_key, const DrawPacket& packet);
+
+        // Pushes a draw with per-draw push constants, copied into the queue
+        template<typename T>
+        inline void push(
+            uint64_t           sort_key,
+            const DrawPacket&  packet,
+            VkShaderStageFlags stage_flags,
+            const T&           constants) {
+
+            static_assert(std::is_trivially_copyable<T>::value, "Push constants must be trivially copyable.");
+            static_assert(sizeof(T) % 4 == 0, "Push constant size must be a multiple of 4.");
+
+            const auto offset = static_cast<uint32_t>(constant_data.size());
+            constant_data.resize(offset + sizeof(T));
+            memcpy(constant_data.data() + offset, &constants, sizeof(T));
+
+            push(sort_key, packet);
+            draws.back().constant_stages = stage_flags;
+            draws.back().constant_offset = offset;
+            draws.back().constant_size   = sizeof(T);
+        }
+
+        // Sorts the queued draws and records them, the queue is left intact until clear
+        void record(const vulkan::CommandBuffer& command_buffer);
+
+        void clear();
+
+        inline size_t size() const { return draws.size(); }
+        inline const RenderQueueStatistics& get_statistics() const { return statistics; }
+        inline void reset_statistics() { statistics = {}; }
+
+    private:
+        struct QueuedDraw {
+            DrawPacket         packet;
+            VkShaderStageFlags constant_stages;
+            uint32_t           constant_offset;
+            uint32_t           constant_size;
+        };
+
+        struct SortEntry {
+            uint64_t key;
+            uint32_t draw;
+        };
+
+        std::vector<QueuedDraw> draws;
+        std::vector<SortEntry>  entries;
+        std::vector<SortEntry>  scratch;
+        std::vector<uint8_t>    constant_data;
+        RenderQueueStatistics   statistics = {};
+
+        void sort();
+    };
+
+}
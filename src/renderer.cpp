@@ -0,0 +1,1007 @@
+#include "vulkan/buffer.hpp"
+#include "vulkan/deleter.hpp"
+#include "vulkan/device.hpp"
+#include "vulkan/device_memory.hpp"
+#include "vulkan/vulkan.hpp"
+
+#include "renderer.hpp"
+#include "simd_math.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <string>
+
+namespace stirling {
+
+    namespace {
+
+        // Frames recorded ahead of the GPU, every view has semaphores for each of them
+        constexpr uint32_t max_frames_in_flight = 2;
+
+        // Queried draws of the first view per swapchain image, later draws are not counted
+        constexpr uint32_t max_statistics_queries = 1024;
+
+        // A coarser level than last frame must also be within this fraction of the threshold, so
+        // objects near a switching distance do not alternate between levels every frame
+        constexpr float lod_hysteresis = 0.75f;
+
+        // Coarsest level whose error projects to at most threshold pixels
+        uint32_t select_lod(const std::vector<MeshLod>& lods, float pixels_per_unit, float threshold, uint32_t previous_lod) {
+            for (auto lod = static_cast<uint32_t>(lods.size()); lod-- > 1;) {
+                const auto limit = lod > previous_lod ? threshold * lod_hysteresis : threshold;
+                if (lods[lod].error * pixels_per_unit <= limit) return lod;
+            }
+            return 0;
+        }
+
+    }
+
+    Renderer::Renderer(const RendererCreateInfo& create_info) :
+        presentation          (create_info.presentation),
+        lod_error_threshold   (create_info.lod_error_threshold),
+        windows               (create_windows(create_info.views)),
+        assets                (create_info.asset_path),
+        instance              (create_instance()),
+        debugger              (create_debugger()),
+        physical_device       (pick_physical_device()),
+        surfaces              (create_surfaces()),
+        surface_format        (get_surface_format()),
+        surface_queues        (get_surface_queues()),
+        bindless              (supports_bindless()),
+        device                (create_device()),
+        graphics_queue        (device.get_queue(surface_queues.graphics_queue, 0)),
+        present_queue         (device.get_queue(surface_queues.present_queue, 0)),
+        descriptor_set_layout (create_descriptor_set_layout()),
+        bindless_descriptors  (create_bindless_descriptors()),
+        pipeline_layout       (create_pipeline_layout()),
+        command_pool          (create_command_pool()),
+        render_pass           (create_render_pass()),
+        pipeline              (create_pipeline()),
+        views                 (create_views(create_info.views)),
+        descriptor_set_cache  (create_descriptor_set_cache()),
+        query_pool            (create_query_pool(create_info.pipeline_statistics)),
+        mesh_loader           (physical_device, device, command_pool, graphics_queue),
+        frame_timeline        (device.create_timeline_semaphore()),
+        deletion_queue        (frame_timeline),
+        camera                {glm::mat4(1.0f), glm::radians(45.0f), 0.1f, 100.0f},
+        camera_position       (0.0f),
+        culling_statistics    {0, 0},
+        lod_statistics        {0, 0},
+        frame_limiter         (presentation.frame_rate_limit),
+        frame_input_times     (max_frames_in_flight),
+        latency_value         (0),
+        frame_value           (0),
+        current_frame         (0),
+        queried_meshes        (views[0].command_buffers.size()),
+        query_results         (max_statistics_queries),
+        statistics_frames     (0) {
+
+        // Get descriptor sets, writes of new sets are queued until flush
+        for (auto& view : views) {
+            for (const auto& uniform_buffer : view.uniform_buffers) {
+                view.descriptor_sets.push_back(descriptor_set_cache.get(descriptor_set_layout, {
+                    {
+                        .binding = 0,
+                        .type    = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                        .buffer  = uniform_buffer,
+                        .offset  = 0,
+                        .range   = sizeof(UniformBufferObject)
+                    }
+                }));
+            }
+        }
+
+        // Update descriptor sets with a single call
+        descriptor_set_cache.flush();
+    }
+
+    Renderer::~Renderer() {
+        // Wait until device is idle, then destroy released resources before the device they belong to
+        device.wait_idle();
+        deletion_queue.flush();
+    }
+
+    MeshHandle Renderer::load_mesh(const MeshFile& mesh_file) {
+        return add_mesh(mesh_loader.load(mesh_file));
+    }
+
+    MeshHandle Renderer::load_mesh(SourceMesh&& mesh, bool optimize) {
+        return add_mesh(mesh_loader.load(std::move(mesh), optimize));
+    }
+
+    bool Renderer::begin_frame() {
+        // Pace before sampling input, so waiting does not add to input latency
+        wait_for_frames(frame_limiter.get_next_frame_time());
+        frame_limiter.wait();
+
+        do {
+            // Sleep until the first view is due, views without a limit are always due
+            auto next_view_frame = FrameLimiter::Clock::time_point::max();
+            for (const auto& view : views) {
+                next_view_frame = std::min(next_view_frame, view.frame_limiter.get_next_frame_time());
+            }
+            wait_for_frames(next_view_frame);
+
+            // Closing any window ends the frame loop
+            Window::poll_events();
+            if (std::any_of(windows.begin(), windows.end(), [](const Window& window) { return window.should_close(); })) {
+                return false;
+            }
+            input_time = std::chrono::steady_clock::now();
+
+            // Collect the views whose next frame is due
+            frame_views.clear();
+            for (uint32_t i = 0; i < views.size(); ++i) {
+                if (views[i].frame_limiter.try_begin_frame(input_time)) {
+                    frame_views.push_back(i);
+                }
+            }
+        } while (frame_views.empty());
+
+        // Wait for the frame that last used this frame's semaphores to be finished
+        ++frame_value;
+        if (frame_value > max_frames_in_flight) {
+            record_completed_frames(frame_value - max_frames_in_flight);
+        }
+
+        // Destroy resources of finished frames and retire new releases with this frame
+        deletion_queue.collect();
+        deletion_queue.set_current_value(frame_value);
+
+        // Frames the timeline reached while no wait was watching it, timestamped on discovery
+        record_completed_frames(std::min(frame_timeline.get_value(), frame_value - 1));
+        frame_input_times[frame_value % max_frames_in_flight] = input_time;
+
+        instances.clear();
+        return true;
+    }
+
+    void Renderer::set_camera(const Camera& camera) {
+        this->camera = camera;
+        camera_position = glm::vec3(glm::inverse(camera.view)[3]);
+    }
+
+    void Renderer::submit(MeshHandle mesh, const glm::mat4& transform) {
+        const auto scale = std::max({
+            glm::length(glm::vec3(transform[0])),
+            glm::length(glm::vec3(transform[1])),
+            glm::length(glm::vec3(transform[2]))
+        });
+        instances.push_back({mesh, multiply_matrix(transform, meshes[mesh].dequantization), scale});
+    }
+
+    void Renderer::end_frame() {
+        wait_semaphores.clear();
+        wait_dst_stage_masks.clear();
+        frame_command_buffers.clear();
+        signal_semaphores.clear();
+        signal_values.clear();
+        present_semaphores.clear();
+        present_swapchains.clear();
+        present_image_indices.clear();
+
+        // Refit the bounds of moved instances once, every view culls against the same tree
+        bounding_volumes.resize(static_cast<uint32_t>(instances.size()));
+        for (uint32_t i = 0; i < instances.size(); ++i) {
+            bounding_volumes.set_bounds(i, transform_unit_box(instances[i].model));
+        }
+        bounding_volumes.refit();
+
+        for (const auto view_index : frame_views) {
+            auto& view = views[view_index];
+
+            // Get next image from swapchain
+            const auto image_index = view.swapchain.acquire_next_image(view.image_available_semaphores[current_frame]);
+
+            // Wait for the frame that last recorded into this image, its command buffer and uniform
+            // buffer are reused without idling the queue
+            record_completed_frames(view.image_frame_values[image_index]);
+            view.image_frame_values[image_index] = frame_value;
+
+            // Accumulate vertex shader invocations of that frame per mesh before the queries are reset
+            const auto view_query_pool = query_pool && view_index == 0 ? static_cast<VkQueryPool>(*query_pool) : VK_NULL_HANDLE;
+            if (view_query_pool != VK_NULL_HANDLE) {
+                auto& image_queries = queried_meshes[image_index];
+                const auto query_count = static_cast<uint32_t>(image_queries.size());
+                if (query_count > 0 &&
+                    query_pool->get_results(image_index * max_statistics_queries, query_count, query_results.data())) {
+                    for (uint32_t i = 0; i < query_count; ++i) {
+                        vertex_invocations[image_queries[i]] += query_results[i];
+                    }
+                    ++statistics_frames;
+                }
+                image_queries.clear();
+            }
+
+            record(view, image_index, view_query_pool);
+
+            wait_semaphores.push_back(view.image_available_semaphores[current_frame]);
+            wait_dst_stage_masks.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+            frame_command_buffers.push_back(view.command_buffers[image_index]);
+            signal_semaphores.push_back(view.render_finished_semaphores[current_frame]);
+            signal_values.push_back(0);
+            present_semaphores.push_back(view.render_finished_semaphores[current_frame]);
+            present_swapchains.push_back(view.swapchain);
+            present_image_indices.push_back(image_index);
+        }
+
+        signal_semaphores.push_back(frame_timeline);
+        signal_values.push_back(frame_value);
+
+        // Submit the command buffers of every due view at once
+        graphics_queue.submit({
+            {{
+                .wait_semaphores      = wait_semaphores,
+                .wait_dst_stage_masks = wait_dst_stage_masks,
+                .command_buffers      = frame_command_buffers,
+                .signal_semaphores    = signal_semaphores,
+                .signal_values        = signal_values
+            }}
+        });
+
+        // Present images of every due view with a single call
+        present_queue.present({{
+            .wait_semaphores = present_semaphores,
+            .swapchains      = present_swapchains,
+            .image_indices   = present_image_indices
+        }});
+
+        // Advance to next frame
+        current_frame = (current_frame + 1) % max_frames_in_flight;
+    }
+
+    void Renderer::record(View& view, uint32_t image_index, VkQueryPool view_query_pool) {
+        // Define uniform buffer object, projected with the aspect ratio of the view
+        UniformBufferObject ubo = {
+            .view       = camera.view,
+            .projection = glm::perspective(camera.vertical_fov, view.extent.width / (float) view.extent.height, camera.near_plane, camera.far_plane)
+        };
+        ubo.projection[1][1] *= -1;
+
+        // Copy uniform buffer object to uniform buffer
+        view.uniform_buffer_memories[image_index].map().copy(&ubo, sizeof(ubo));
+
+        // Only instances intersecting the frustum of the uniform buffer's camera are drawn
+        bounding_volumes.cull(make_frustum(multiply_matrix(ubo.projection, ubo.view)), visible_instances, &worker_pool);
+        culling_statistics.submitted_draws += instances.size();
+        culling_statistics.visible_draws += visible_instances.size();
+
+        // Record command buffer, per-draw data is pushed with each draw instead of written to memory
+        const auto& command_buffer = view.command_buffers[image_index];
+        const auto first_query = image_index * max_statistics_queries;
+
+        command_buffer.begin({{
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+        }});
+
+        if (view_query_pool != VK_NULL_HANDLE) {
+            command_buffer.reset_query_pool(view_query_pool, first_query, max_statistics_queries);
+        }
+
+        // Pixels covered by one world unit at unit distance, the projected error of a level is its
+        // error in world units times this, divided by the distance
+        const auto pixels_per_unit = view.extent.height / (2.0f * std::tan(camera.vertical_fov * 0.5f));
+        view.instance_lods.resize(instances.size(), 0);
+
+        // Queue visible draws, sorted front to back within the single pipeline and material
+        render_queue.clear();
+        auto& image_queries = queried_meshes[view_query_pool != VK_NULL_HANDLE ? image_index : 0];
+        for (const auto i : visible_instances) {
+            const auto& mesh_instance = instances[i];
+            const auto& mesh = meshes[mesh_instance.mesh];
+            const auto& model = mesh_instance.model;
+
+            // Distance to the nearest point of the bounds, levels are full detail from within them
+            uint32_t lod = 0;
+            if (lod_error_threshold > 0.0f) {
+                const auto& bounds = bounding_volumes.get_bounds(i);
+                const auto distance = std::max(
+                    glm::distance(camera_position, bounds.center) - glm::length(bounds.extent), camera.near_plane);
+                lod = select_lod(mesh.lods, mesh_instance.scale * pixels_per_unit / distance, lod_error_threshold, view.instance_lods[i]);
+            }
+            view.instance_lods[i] = static_cast<uint8_t>(lod);
+
+            const auto& mesh_lod = mesh.lods[lod];
+            lod_statistics.full_triangles += mesh.lods[0].index_count / 3;
+            lod_statistics.drawn_triangles += mesh_lod.index_count / 3;
+
+            const auto query = static_cast<uint32_t>(image_queries.size());
+            const auto queried = view_query_pool != VK_NULL_HANDLE && query < max_statistics_queries;
+            if (queried) {
+                image_queries.push_back(mesh_instance.mesh);
+            }
+
+            render_queue.push(make_sort_key(0, 0, 0, glm::distance(camera_position, glm::vec3(model[3]))), {
+                .pipeline        = pipeline,
+                .pipeline_layout = pipeline_layout,
+                .descriptor_set  = view.descriptor_sets[image_index],
+                .vertex_buffer   = mesh.buffer,
+                .index_buffer    = mesh.buffer,
+                .index_offset    = mesh.index_offset,
+                .index_type      = mesh.index_type,
+                .index_count     = mesh_lod.index_count,
+                .first_index     = mesh_lod.index_offset,
+                .vertex_offset   = 0,
+                .query_pool      = queried ? view_query_pool : VK_NULL_HANDLE,
+                .query           = first_query + query
+            }, VK_SHADER_STAGE_VERTEX_BIT, DrawConstants {
+                .model        = model,
+                .object_index = i
+            });
+        }
+
+        command_buffer.begin_render_pass({{
+            .render_pass  = render_pass,
+            .framebuffer  = view.framebuffers[image_index],
+            .render_area  = {
+                .offset = { 0, 0 },
+                .extent = view.extent
+            },
+            .clear_values = {
+                { 0.0f, 0.0f, 0.0f, 1.0f }
+            }
+        }}, VK_SUBPASS_CONTENTS_INLINE);
+
+        // The pipeline is shared by every view, so viewport and scissor are dynamic
+        command_buffer
+            .set_viewport(0, {
+                {
+                    .x        = 0.0f,
+                    .y        = 0.0f,
+                    .width    = static_cast<float>(view.extent.width),
+                    .height   = static_cast<float>(view.extent.height),
+                    .minDepth = 0.0f,
+                    .maxDepth = 1.0f
+                }
+            })
+            .set_scissor(0, {
+                {
+                    .offset = { 0, 0 },
+                    .extent = view.extent
+                }
+            });
+
+        if (bindless_descriptors) {
+            command_buffer.bind_descriptor_sets(
+                VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 1, { *bindless_descriptors }, {});
+        }
+
+        // Record sorted draws, binding only state that changed
+        render_queue.record(command_buffer);
+
+        command_buffer
+            .end_render_pass()
+            .end();
+    }
+
+    std::vector<Window> Renderer::create_windows(const std::vector<ViewSettings>& view_settings) const {
+        if (view_settings.empty()) throw "At least one window is required.";
+
+        std::vector<Window> windows;
+        for (size_t i = 0; i < view_settings.size(); ++i) {
+            const auto title = i == 0 ? std::string("Stirling Engine") : "Stirling Engine " + std::to_string(i + 1);
+            windows.emplace_back(view_settings[i].width, view_settings[i].height, title.c_str());
+        }
+        return windows;
+    }
+
+    vulkan::Instance Renderer::create_instance() const {
+        // Set enabled extensions, every window requires the same ones
+        auto enabled_extensions = windows[0].get_required_instance_extensions();
+        enabled_extensions.emplace_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
+
+        // Create instance
+        return {{
+            .application_info = {{
+                .application_name    = "Stirling Engine Demo",
+                .application_version = VK_MAKE_VERSION(1, 0, 0),
+                .engine_name         = "Stirling Engine",
+                .engine_version      = VK_MAKE_VERSION(1, 0, 0),
+                .api_version         = VK_API_VERSION_1_1
+            }},
+            .enabled_layers = {
+                "VK_LAYER_LUNARG_standard_validation"
+            },
+            .enabled_extensions = enabled_extensions
+        }};
+    }
+
+    vulkan::DebugReportCallback Renderer::create_debugger() const {
+        return instance.create_debug_report_callback({{
+            .flags     = VK_DEBUG_REPORT_ERROR_BIT_EXT | VK_DEBUG_REPORT_WARNING_BIT_EXT,
+            .callback  = [](
+                VkDebugReportFlagsEXT      flags,
+                VkDebugReportObjectTypeEXT object_type,
+                uint64_t                   object,
+                size_t                     location,
+                int32_t                    message_code,
+                const char*                layer_prefix,
+                const char*                message,
+                void*                      user_data) -> VkBool32 {
+
+                std::cerr << "\033[1;31m[stirling]\033[0m " << message << '\n';
+                return VK_FALSE;
+            }
+        }});
+    }
+
+    vulkan::PhysicalDevice Renderer::pick_physical_device() const {
+        const auto physical_devices = instance.get_physical_devices();
+        for (const auto& physical_device : physical_devices) {
+            const auto properties = physical_device.get_properties();
+            const auto features = physical_device.get_features();
+
+            // Frame and upload completion are tracked with timeline semaphores
+            if (!physical_device.supports_extension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) ||
+                !physical_device.get_timeline_semaphore_features().timelineSemaphore) {
+                continue;
+            }
+
+            return physical_device;
+        }
+        throw "Failed to find a suitable GPU.";
+    }
+
+    std::vector<vulkan::Surface> Renderer::create_surfaces() const {
+        std::vector<vulkan::Surface> surfaces;
+        for (const auto& window : windows) {
+            surfaces.push_back(instance.create_surface(window));
+        }
+        return surfaces;
+    }
+
+    vulkan::QueueFamilyIndices Renderer::get_surface_queues() const {
+        // Every window is presented from the same queue, so presents can be batched
+        const auto queue_families = physical_device.get_queue_families(surfaces[0]);
+        for (const auto& surface : surfaces) {
+            if (!surface.get_present_support(physical_device, queue_families.present_queue)) {
+                throw "Failed to find a queue presenting to every window.";
+            }
+        }
+        return queue_families;
+    }
+
+    bool Renderer::supports_bindless() const {
+        if (!physical_device.supports_extension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+            return false;
+        }
+
+        const auto features = physical_device.get_descriptor_indexing_features();
+        return features.shaderSampledImageArrayNonUniformIndexing &&
+               features.shaderStorageBufferArrayNonUniformIndexing &&
+               features.descriptorBindingSampledImageUpdateAfterBind &&
+               features.descriptorBindingStorageBufferUpdateAfterBind &&
+               features.descriptorBindingUpdateUnusedWhilePending &&
+               features.descriptorBindingPartiallyBound &&
+               features.runtimeDescriptorArray;
+    }
+
+    vulkan::Device Renderer::create_device() const {
+        // Descriptor indexing features used by the bindless table, chained only when supported
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexing_features {
+            .sType                                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT,
+            .shaderSampledImageArrayNonUniformIndexing      = VK_TRUE,
+            .shaderStorageBufferArrayNonUniformIndexing     = VK_TRUE,
+            .descriptorBindingSampledImageUpdateAfterBind   = VK_TRUE,
+            .descriptorBindingStorageBufferUpdateAfterBind  = VK_TRUE,
+            .descriptorBindingUpdateUnusedWhilePending      = VK_TRUE,
+            .descriptorBindingPartiallyBound                = VK_TRUE,
+            .runtimeDescriptorArray                         = VK_TRUE
+        };
+
+        // Timeline semaphores are required by pick_physical_device
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_features {
+            .sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR,
+            .pNext             = bindless ? &indexing_features : nullptr,
+            .timelineSemaphore = VK_TRUE
+        };
+
+        std::vector<const char*> enabled_extensions = {
+            VK_KHR_SWAPCHAIN_EXTENSION_NAME,
+            VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME
+        };
+        if (bindless) {
+            enabled_extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+        }
+
+        return physical_device.create_device({
+            .queues = [this]() {
+                std::vector<vulkan::DeviceQueueCreateInfo> create_infos;
+                // Only one queue per unique queue family index
+                for (const auto queue_family : std::set<uint32_t>{
+                    surface_queues.graphics_queue,
+                    surface_queues.present_queue
+                }) {
+                    create_infos.push_back({{
+                        .queue_family_index = surface_queues.graphics_queue,
+                        .queue_priorities   = { 1.0f }
+                    }});
+                }
+                return create_infos;
+            }(),
+            .enabled_extensions = enabled_extensions,
+            .enabled_features = [this]() {
+                // Enable every texture compression family the device supports, streamed
+                // textures pick between them per file through format properties
+                const auto supported_features = physical_device.get_features();
+                return VkPhysicalDeviceFeatures {
+                    .fullDrawIndexUint32        = supported_features.fullDrawIndexUint32,
+                    .geometryShader             = VK_TRUE,
+                    .samplerAnisotropy          = supported_features.samplerAnisotropy,
+                    .textureCompressionETC2     = supported_features.textureCompressionETC2,
+                    .textureCompressionASTC_LDR = supported_features.textureCompressionASTC_LDR,
+                    .textureCompressionBC       = supported_features.textureCompressionBC,
+                    .pipelineStatisticsQuery    = supported_features.pipelineStatisticsQuery
+                };
+            }(),
+            .next = &timeline_features
+        });
+    }
+
+    vulkan::DescriptorSetLayout Renderer::create_descriptor_set_layout() const {
+        return device.create_descriptor_set_layout({
+            .bindings = {
+                {{
+                    .binding         = 0,
+                    .descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                    .descriptorCount = 1,
+                    .stageFlags      = VK_SHADER_STAGE_VERTEX_BIT
+                }}
+            }
+        });
+    }
+
+    std::optional<vulkan::BindlessDescriptors> Renderer::create_bindless_descriptors() const {
+        if (!bindless) return std::nullopt;
+
+        // Table sizes are bounded by the update-after-bind limits of the device
+        const auto properties = physical_device.get_descriptor_indexing_properties();
+        return device.create_bindless_descriptors({
+            .max_textures = std::min({
+                4096u,
+                properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                properties.maxPerStageDescriptorUpdateAfterBindSamplers
+            }),
+            .max_buffers  = std::min(1024u, properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers)
+        });
+    }
+
+    vulkan::PipelineLayout Renderer::create_pipeline_layout() const {
+        // The bindless table, when negotiated, is bound as set 1
+        std::vector<VkDescriptorSetLayout> set_layouts = {
+            descriptor_set_layout
+        };
+        if (bindless_descriptors) {
+            set_layouts.push_back(bindless_descriptors->get_layout());
+        }
+
+        return device.create_pipeline_layout({
+            .set_layouts          = set_layouts,
+            .push_constant_ranges = {
+                vulkan::get_push_constant_range<DrawConstants>(VK_SHADER_STAGE_VERTEX_BIT)
+            }
+        });
+    }
+
+    vulkan::CommandPool Renderer::create_command_pool() const {
+        // Command buffers are re-recorded every frame
+        return device.create_command_pool({
+            .flags              = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+            .queue_family_index = surface_queues.graphics_queue
+        });
+    }
+
+    vulkan::SurfaceFormat Renderer::get_surface_format() const {
+        const auto supports_format = [this](const vulkan::Surface& surface, vulkan::SurfaceFormat format) {
+            const auto surface_formats = surface.get_formats(physical_device);
+            if (surface_formats.size() == 1 && surface_formats[0].format == VK_FORMAT_UNDEFINED) {
+                return true;
+            }
+            return std::any_of(surface_formats.begin(), surface_formats.end(), [&format](const auto& surface_format) {
+                return surface_format.format == format.format && surface_format.colorSpace == format.colorSpace;
+            });
+        };
+
+        // Views share the render pass, so the format is picked from the first surface and must
+        // be supported by every other
+        const auto surface_format = [&]() -> vulkan::SurfaceFormat {
+            const vulkan::SurfaceFormat preferred_format = { VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
+            if (supports_format(surfaces[0], preferred_format)) {
+                return preferred_format;
+            }
+            return surfaces[0].get_formats(physical_device)[0];
+        }();
+
+        for (const auto& surface : surfaces) {
+            if (!supports_format(surface, surface_format)) {
+                throw "Failed to find a surface format shared by every window.";
+            }
+        }
+        return surface_format;
+    }
+
+    vulkan::Extent2D Renderer::get_surface_extent(
+        const vulkan::Surface& surface,
+        uint32_t               width,
+        uint32_t               height) const {
+
+        const auto surface_capabilities = surface.get_capabilities(physical_device);
+        if (surface_capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
+            return surface_capabilities.currentExtent;
+        } else {
+            return {
+                .width = std::max(surface_capabilities.minImageExtent.width, std::min(surface_capabilities.maxImageExtent.width, width)),
+                .height = std::max(surface_capabilities.minImageExtent.height, std::min(surface_capabilities.maxImageExtent.height, height))
+            };
+        }
+    }
+
+    vulkan::Swapchain Renderer::create_swapchain(
+        const vulkan::Surface& surface,
+        vulkan::Extent2D       extent) const {
+
+        // Get swap images count, fewer images queue fewer frames ahead of the display
+        const auto surface_capabilities = surface.get_capabilities(physical_device);
+        const auto swap_image_count = select_image_count(presentation.image_count, surface_capabilities);
+
+        // Get swap present mode of the presentation policy
+        const auto present_mode = select_present_mode(presentation.policy, surface.get_present_modes(physical_device));
+
+        // Create swapchain
+        const bool concurrent = surface_queues.graphics_queue != surface_queues.present_queue;
+        return device.create_swapchain({
+            .surface              = surface,
+            .min_image_count      = swap_image_count,
+            .image_format         = surface_format.format,
+            .image_color_space    = surface_format.colorSpace,
+            .image_extent         = extent,
+            .image_array_layers   = 1,
+            .image_usage          = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+            .image_sharing_mode   =
+                concurrent ?
+                    VK_SHARING_MODE_CONCURRENT :
+                    VK_SHARING_MODE_EXCLUSIVE,
+            .queue_family_indices =
+                concurrent ?
+                    std::vector<uint32_t>{
+                        surface_queues.graphics_queue,
+                        surface_queues.present_queue
+                    } :
+                    std::vector<uint32_t>{},
+            .pre_transform        = surface_capabilities.currentTransform,
+            .composite_alpha      = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
+            .present_mode         = present_mode,
+            .clipped              = VK_TRUE,
+            .old_swapchain        = VK_NULL_HANDLE
+        });
+    }
+
+    std::vector<vulkan::ImageView> Renderer::create_image_views(const vulkan::Swapchain& swapchain) const {
+        // Get swapchain images
+        const auto swapchain_images = swapchain.get_images();
+        
+        std::vector<vulkan::ImageView> image_views{swapchain_images.size()};
+        for (size_t i = 0; i < swapchain_images.size(); ++i) {
+            image_views[i] = device.create_image_view({
+                .image      = swapchain_images[i],
+                .view_type  = VK_IMAGE_VIEW_TYPE_2D,
+                .format     = surface_format.format,
+                .components = {
+                    .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+                    .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+                    .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+                    .a = VK_COMPONENT_SWIZZLE_IDENTITY
+                },
+                .subresource_range = {
+                    .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .baseMipLevel   = 0,
+                    .levelCount     = 1,
+                    .baseArrayLayer = 0,
+                    .layerCount     = 1
+                }
+            });
+        }
+        return image_views;
+    }
+
+    vulkan::RenderPass Renderer::create_render_pass() const {
+        return device.create_render_pass({
+            .attachments = {
+                {{
+                    .format           = surface_format.format,
+                    .samples          = VK_SAMPLE_COUNT_1_BIT,
+                    .load_op          = VK_ATTACHMENT_LOAD_OP_CLEAR,
+                    .store_op         = VK_ATTACHMENT_STORE_OP_STORE,
+                    .stencil_load_op  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                    .stencil_store_op = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                    .initial_layout   = VK_IMAGE_LAYOUT_UNDEFINED,
+                    .final_layout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+                }}
+            },
+            .subpasses = {
+                {{
+                    .pipeline_bind_point = VK_PIPELINE_BIND_POINT_GRAPHICS,
+                    .color_attachments = {
+                        {
+                            .attachment = 0,
+                            .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+                        }
+                    },
+                }}
+            },
+            .dependencies = {
+                {{
+                    // Subpasses
+                    .src_subpass = VK_SUBPASS_EXTERNAL,
+                    .dst_subpass = 0,
+
+                    // Stage masks
+                    .src_stage_mask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    .dst_stage_mask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+
+                    // Access masks
+                    .src_access_mask = 0,
+                    .dst_access_mask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                }}
+            }
+        });
+    }
+
+    vulkan::Pipeline Renderer::create_pipeline() const {    
+        return device.create_pipeline({
+            .stages = {
+                // Vertex shader stage
+                {
+                    .stage  = VK_SHADER_STAGE_VERTEX_BIT,
+                    .module = create_shader_module("vert.spv"),
+                    .name   = "main",
+                },
+                // Geometry shader stage
+                {
+                    .stage  = VK_SHADER_STAGE_GEOMETRY_BIT,
+                    .module = create_shader_module("geom.spv"),
+                    .name   = "main",
+                },
+                // Fragment shader stage
+                {
+                    .stage  = VK_SHADER_STAGE_FRAGMENT_BIT,
+                    .module = create_shader_module("frag.spv"),
+                    .name   = "main",
+                }
+            },
+
+            .vertex_input_state = MeshVertexLayout::get_input_state(),
+
+            .input_assembly_state = {
+                .topology                 = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+                .primitive_restart_enable = VK_FALSE
+            },
+
+            // Set per view while recording, the extents are ignored
+            .viewport_state = {
+                .viewports = {
+                    VkViewport {}
+                },
+
+                .scissors = {
+                    VkRect2D {}
+                }
+            },
+
+            .rasterization_state = {
+                .depth_clamp_enable         = VK_FALSE,
+                .rasterizer_discard_enable  = VK_FALSE,
+                .polygon_mode               = VK_POLYGON_MODE_FILL,
+                .cull_mode                  = VK_CULL_MODE_BACK_BIT,
+                .front_face                 = VK_FRONT_FACE_COUNTER_CLOCKWISE,
+                .depth_bias_enable          = VK_FALSE,
+                .depth_bias_constant_factor = 0.0f,
+                .depth_bias_clamp           = 0.0f,
+                .depth_bias_slope_factor    = 0.0f,
+                .line_width                 = 1.0f
+            },
+
+            .multisample_state = {
+                .rasterization_samples = VK_SAMPLE_COUNT_1_BIT,
+                .min_sample_shading    = 1.0f,
+            },
+
+            .color_blend_state = {
+                .logic_op_enable = VK_FALSE,
+                .attachments = {
+                    {{
+                        .blendEnable         = VK_FALSE,
+                        .srcColorBlendFactor = VK_BLEND_FACTOR_ONE,
+                        .dstColorBlendFactor = VK_BLEND_FACTOR_ZERO,
+                        .colorBlendOp        = VK_BLEND_OP_ADD,
+                        .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+                        .dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+                        .alphaBlendOp        = VK_BLEND_OP_ADD,
+                        .colorWriteMask      = VK_COLOR_COMPONENT_R_BIT
+                                             | VK_COLOR_COMPONENT_G_BIT
+                                             | VK_COLOR_COMPONENT_B_BIT
+                                             | VK_COLOR_COMPONENT_A_BIT
+                    }}
+                },
+
+                .blend_constants = { 0.0f, 0.0f, 0.0f, 0.0f }
+            },
+
+            .dynamic_state = {
+                .dynamic_states = {
+                    VK_DYNAMIC_STATE_VIEWPORT,
+                    VK_DYNAMIC_STATE_SCISSOR
+                }
+            },
+
+            .layout = pipeline_layout,
+
+            .render_pass = render_pass,
+        }, VK_NULL_HANDLE);
+    }
+
+    Deleter<VkShaderModule> Renderer::create_shader_module(const char* name) const {
+        // Uncompressed entries are handed to the driver straight from the archive mapping
+        const auto code = assets.load(name);
+        return device.create_shader_module({
+            .sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+            .codeSize = code.size,
+            .pCode    = reinterpret_cast<const uint32_t*>(code.data)
+        });
+    }
+
+    std::vector<vulkan::Framebuffer> Renderer::create_framebuffers(
+        const std::vector<vulkan::ImageView>& image_views,
+        vulkan::Extent2D                      extent) const {
+
+        std::vector<vulkan::Framebuffer> framebuffers{image_views.size()};
+        for (size_t i = 0; i < framebuffers.size(); ++i) {
+            framebuffers[i] = device.create_framebuffer({
+                .render_pass = render_pass,
+                .attachments = {{
+                    image_views[i]
+                }},
+                .width  = extent.width,
+                .height = extent.height,
+                .layers = 1
+            });
+        }
+        return framebuffers;
+    };
+
+    std::vector<View> Renderer::create_views(const std::vector<ViewSettings>& view_settings) const {
+        std::vector<View> views;
+        for (size_t i = 0; i < surfaces.size(); ++i) {
+            const auto extent = get_surface_extent(surfaces[i], view_settings[i].width, view_settings[i].height);
+            auto swapchain = create_swapchain(surfaces[i], extent);
+            auto image_views = create_image_views(swapchain);
+            auto framebuffers = create_framebuffers(image_views, extent);
+            const auto image_count = image_views.size();
+
+            // Command buffers are recorded per swapchain image
+            auto command_buffers = command_pool.allocate_command_buffers({
+                .level                = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                .command_buffer_count = static_cast<uint32_t>(framebuffers.size())
+            });
+
+            // Create uniform buffers, one per swapchain image
+            std::vector<vulkan::Buffer>       uniform_buffers;
+            std::vector<vulkan::DeviceMemory> uniform_buffer_memories;
+            for (size_t j = 0; j < image_views.size(); ++j) {
+                // Create uniform buffer
+                uniform_buffers.emplace_back(device.create_buffer({
+                    .size         = sizeof(UniformBufferObject),
+                    .usage        = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                    .sharing_mode = VK_SHARING_MODE_EXCLUSIVE,
+                }));
+
+                // Find memory requirements for uniform buffer
+                const auto memory_requirements = uniform_buffers[j].get_memory_requirements();
+
+                // Allocate memory for uniform buffer
+                uniform_buffer_memories.emplace_back(device.allocate_memory({
+                    .allocation_size   = memory_requirements.size,
+                    .memory_type_index = physical_device.find_memory_type(
+                        memory_requirements.memoryTypeBits,
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                    )
+                }));
+
+                // Bind memory to uniform buffer
+                uniform_buffers[j].bind(uniform_buffer_memories[j], 0);
+            }
+
+            views.push_back({
+                .extent                     = extent,
+                .swapchain                  = std::move(swapchain),
+                .image_views                = std::move(image_views),
+                .framebuffers               = std::move(framebuffers),
+                .command_buffers            = std::move(command_buffers),
+                .image_frame_values         = std::vector<uint64_t>(image_count, 0),
+                .image_available_semaphores = device.create_semaphores(max_frames_in_flight),
+                .render_finished_semaphores = device.create_semaphores(max_frames_in_flight),
+                .uniform_buffers            = std::move(uniform_buffers),
+                .uniform_buffer_memories    = std::move(uniform_buffer_memories),
+                .descriptor_sets            = {},
+                .frame_limiter              = FrameLimiter(view_settings[i].frame_rate_limit)
+            });
+        }
+        return views;
+    }
+
+    vulkan::DescriptorSetCache Renderer::create_descriptor_set_cache() const {
+        size_t image_count = 0;
+        for (const auto& view : views) {
+            image_count += view.image_views.size();
+        }
+
+        // Sets are shared by every user of the same resources
+        return device.create_descriptor_set_cache({
+            .initial_sets      = static_cast<uint32_t>(image_count),
+            .max_sets_per_pool = 256,
+            .ratios            = {
+                {
+                    .type  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                    .ratio = 1.0f
+                }
+            }
+        });
+    }
+
+    std::optional<vulkan::QueryPool> Renderer::create_query_pool(bool pipeline_statistics) const {
+        if (!pipeline_statistics) return std::nullopt;
+
+        if (!physical_device.get_features().pipelineStatisticsQuery) {
+            throw "Pipeline statistics queries are not supported.";
+        }
+
+        // Draws of the first view are queried, up to a fixed count per swapchain image
+        return device.create_query_pool({
+            .query_type          = VK_QUERY_TYPE_PIPELINE_STATISTICS,
+            .query_count         = static_cast<uint32_t>(views[0].framebuffers.size()) * max_statistics_queries,
+            .pipeline_statistics = VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT
+        });
+    }
+
+    MeshHandle Renderer::add_mesh(Mesh&& mesh) {
+        meshes.push_back(std::move(mesh));
+        vertex_invocations.push_back(0);
+        return static_cast<MeshHandle>(meshes.size() - 1);
+    }
+
+    void Renderer::record_completed_frames(uint64_t value) {
+        // Frames complete in order, each is timestamped as soon as the wait for it returns
+        for (; latency_value < value; ++latency_value) {
+            frame_timeline.wait(latency_value + 1);
+            input_latency.add(std::chrono::steady_clock::now() - frame_input_times[(latency_value + 1) % max_frames_in_flight]);
+        }
+    }
+
+    void Renderer::wait_for_frames(FrameLimiter::Clock::time_point deadline) {
+        using Clock = FrameLimiter::Clock;
+
+        // Sleep on the frame timeline while submitted frames are unfinished, so a frame completing
+        // during the pacing wait is timestamped when it completes instead of when the wait ends
+        while (latency_value < frame_value) {
+            const auto now = Clock::now();
+            if (now >= deadline) break;
+
+            const auto timeout = deadline == Clock::time_point::max()
+                ? std::numeric_limits<uint64_t>::max()
+                : static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count());
+            if (!frame_timeline.wait(latency_value + 1, timeout)) break;
+            record_completed_frames(latency_value + 1);
+        }
+
+        // Spin out the rest for an accurate wake up
+        wait_until(deadline);
+    }
+
+}
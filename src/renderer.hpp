@@ -0,0 +1,242 @@
+#pragma once
+
+#include "archive.hpp"
+#include "bounding_volume_hierarchy.hpp"
+#include "frame_pacing.hpp"
+#include "mesh.hpp"
+#include "render_queue.hpp"
+#include "vulkan/deletion_queue.hpp"
+#include "vulkan/instance.hpp"
+#include "window.hpp"
+#include "worker_pool.hpp"
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace stirling {
+
+    struct UniformBufferObject {
+        glm::mat4 view;
+        glm::mat4 projection;
+    };
+
+    // Per-draw data, pushed with every draw instead of written to a uniform buffer
+    struct DrawConstants {
+        glm::mat4 model;
+        uint32_t  object_index;
+    };
+
+    static_assert(sizeof(DrawConstants) <= 128, "Draw constants exceed the guaranteed push constant size.");
+
+    struct ViewSettings {
+        uint32_t width;
+        uint32_t height;
+        double   frame_rate_limit; // Frames per second of this window, 0 renders it every frame
+    };
+
+    // Window presented from the shared device. Each view owns its swapchain and the resources
+    // recorded against its images, the render pass, pipeline and meshes are shared by all views.
+    struct View {
+        vulkan::Extent2D                    extent;
+        vulkan::Swapchain                   swapchain;
+        std::vector<vulkan::ImageView>      image_views;
+        std::vector<vulkan::Framebuffer>    framebuffers;
+        std::vector<vulkan::CommandBuffer>  command_buffers;
+        std::vector<uint64_t>               image_frame_values; // Frame that last recorded each image's command buffer and uniform buffer
+        std::vector<Deleter<VkSemaphore>>   image_available_semaphores;
+        std::vector<Deleter<VkSemaphore>>   render_finished_semaphores;
+        std::vector<vulkan::Buffer>         uniform_buffers;
+        std::vector<vulkan::DeviceMemory>   uniform_buffer_memories;
+        std::vector<VkDescriptorSet>        descriptor_sets;
+        FrameLimiter                        frame_limiter;
+        std::vector<uint8_t>                instance_lods; // Level of detail each instance was last drawn with
+    };
+
+    // Shared by every view, the projection of each view follows its aspect ratio
+    struct Camera {
+        glm::mat4 view;
+        float     vertical_fov;
+        float     near_plane;
+        float     far_plane;
+    };
+
+    // Draws of every rendered view, summed over all frames
+    struct CullingStatistics {
+        uint64_t submitted_draws;
+        uint64_t visible_draws;
+    };
+
+    // Triangles of every visible draw, summed over all frames
+    struct LodStatistics {
+        uint64_t full_triangles;
+        uint64_t drawn_triangles;
+    };
+
+    struct RendererCreateInfo {
+        std::vector<ViewSettings> views;
+        PresentationSettings      presentation;
+        const char*               asset_path;
+        bool                      pipeline_statistics; // Counts vertex shader invocations of draws in the first view
+        float                     lod_error_threshold; // Largest error of a level of detail in pixels, 0 draws full detail
+    };
+
+    using MeshHandle = uint32_t;
+
+    // Owns the device, the windows and every resource needed to draw submitted meshes. A frame is
+    // driven by begin_frame, any number of submits and end_frame.
+    struct Renderer {
+        Renderer(const RendererCreateInfo& create_info);
+        ~Renderer();
+
+        Renderer(const Renderer&) = delete;
+        Renderer& operator=(const Renderer&) = delete;
+
+        MeshHandle load_mesh(const MeshFile& mesh_file);
+        MeshHandle load_mesh(SourceMesh&& mesh, bool optimize = true);
+        inline const Mesh& get_mesh(MeshHandle mesh) const { return meshes[mesh]; }
+
+        // Paces and waits for the next frame, returns false once a window is closed
+        bool begin_frame();
+
+        void set_camera(const Camera& camera);
+
+        // Draws the mesh in every view due this frame where its bounds intersect the view frustum. The
+        // instance is its index within the frame, instances keeping their index and transform across
+        // frames are not refit.
+        void submit(MeshHandle mesh, const glm::mat4& transform);
+
+        // Records, submits and presents the submitted meshes in every due view
+        void end_frame();
+
+        inline const Archive& get_assets() const { return assets; }
+        inline const vulkan::PhysicalDevice& get_physical_device() const { return physical_device; }
+        inline const vulkan::Device& get_device() const { return device; }
+        inline const vulkan::Queue& get_graphics_queue() const { return graphics_queue; }
+        inline const vulkan::CommandPool& get_command_pool() const { return command_pool; }
+
+        // Resources released here are destroyed once the frame being built completes
+        inline vulkan::DeletionQueue& get_deletion_queue() { return deletion_queue; }
+
+        inline const RenderQueueStatistics& get_render_queue_statistics() const { return render_queue.get_statistics(); }
+        inline const LatencyStatistics& get_input_latency() const { return input_latency; }
+        inline const CullingStatistics& get_culling_statistics() const { return culling_statistics; }
+        inline const LodStatistics& get_lod_statistics() const { return lod_statistics; }
+
+        // Vertex shader invocations summed over every queried frame, when pipeline statistics are enabled
+        inline uint64_t get_vertex_invocations(MeshHandle mesh) const { return vertex_invocations[mesh]; }
+        inline uint64_t get_statistics_frame_count() const { return statistics_frames; }
+
+    private:
+        struct MeshInstance {
+            MeshHandle mesh;
+            glm::mat4  model; // Includes the dequantization of the mesh
+            float      scale; // Largest axis scale of the transform, from mesh to world units
+        };
+
+        PresentationSettings                       presentation;
+        float                                      lod_error_threshold;
+        std::vector<Window>                        windows;
+        Archive                                    assets;
+        vulkan::Instance                           instance;
+        vulkan::DebugReportCallback                debugger;
+        vulkan::PhysicalDevice                     physical_device;
+        std::vector<vulkan::Surface>               surfaces;
+        vulkan::SurfaceFormat                      surface_format;
+        vulkan::QueueFamilyIndices                 surface_queues;
+        bool                                       bindless;
+        vulkan::Device                             device;
+        vulkan::Queue                              graphics_queue;
+        vulkan::Queue                              present_queue;
+        vulkan::DescriptorSetLayout                descriptor_set_layout;
+        std::optional<vulkan::BindlessDescriptors> bindless_descriptors;
+        vulkan::PipelineLayout                     pipeline_layout;
+        vulkan::CommandPool                        command_pool;
+        vulkan::RenderPass                         render_pass;
+        vulkan::Pipeline                           pipeline;
+        std::vector<View>                          views;
+        vulkan::DescriptorSetCache                 descriptor_set_cache;
+        std::optional<vulkan::QueryPool>           query_pool;
+        MeshLoader                                 mesh_loader;
+        vulkan::TimelineSemaphore                  frame_timeline;
+        vulkan::DeletionQueue                      deletion_queue;
+
+        // Meshes and the draws submitted for the current frame
+        std::vector<Mesh>                          meshes;
+        std::vector<MeshInstance>                  instances;
+        Camera                                     camera;
+        glm::vec3                                  camera_position;
+        RenderQueue                                render_queue;
+
+        // Instance bounds, culled against the frustum of every view
+        WorkerPool                                 worker_pool;
+        BoundingVolumeHierarchy                    bounding_volumes;
+        std::vector<uint32_t>                      visible_instances;
+        CullingStatistics                          culling_statistics;
+        LodStatistics                              lod_statistics;
+
+        // Frame pacing, frame n signals value n of the frame timeline on completion
+        FrameLimiter                               frame_limiter;
+        LatencyStatistics                          input_latency;
+        std::chrono::steady_clock::time_point      input_time;
+        std::vector<std::chrono::steady_clock::time_point> frame_input_times; // Input time per frame in flight
+        uint64_t                                   latency_value; // Last frame whose completion was timestamped
+        uint64_t                                   frame_value;
+        size_t                                     current_frame;
+
+        // Views due in a frame are submitted and presented together, storage is reused across frames
+        std::vector<uint32_t>                      frame_views;
+        std::vector<VkSemaphore>                   wait_semaphores;
+        std::vector<VkPipelineStageFlags>          wait_dst_stage_masks;
+        std::vector<VkCommandBuffer>               frame_command_buffers;
+        std::vector<VkSemaphore>                   signal_semaphores;
+        std::vector<uint64_t>                      signal_values;
+        std::vector<VkSemaphore>                   present_semaphores;
+        std::vector<VkSwapchainKHR>                present_swapchains;
+        std::vector<uint32_t>                      present_image_indices;
+
+        // Pipeline statistics of the first view, one query per visible instance, read back once the
+        // image is acquired again
+        std::vector<std::vector<MeshHandle>>       queried_meshes;
+        std::vector<uint64_t>                      query_results;
+        std::vector<uint64_t>                      vertex_invocations;
+        uint64_t                                   statistics_frames;
+
+        std::vector<Window>                        create_windows(const std::vector<ViewSettings>& view_settings) const;
+        vulkan::Instance                           create_instance() const;
+        vulkan::DebugReportCallback                create_debugger() const;
+        vulkan::PhysicalDevice                     pick_physical_device() const;
+        std::vector<vulkan::Surface>               create_surfaces() const;
+        vulkan::QueueFamilyIndices                 get_surface_queues() const;
+        bool                                       supports_bindless() const;
+        vulkan::Device                             create_device() const;
+        vulkan::DescriptorSetLayout                create_descriptor_set_layout() const;
+        std::optional<vulkan::BindlessDescriptors> create_bindless_descriptors() const;
+        vulkan::PipelineLayout                     create_pipeline_layout() const;
+        vulkan::CommandPool                        create_command_pool() const;
+        vulkan::SurfaceFormat                      get_surface_format() const;
+        vulkan::Extent2D                           get_surface_extent(const vulkan::Surface& surface, uint32_t width, uint32_t height) const;
+        vulkan::Swapchain                          create_swapchain(const vulkan::Surface& surface, vulkan::Extent2D extent) const;
+        std::vector<vulkan::ImageView>             create_image_views(const vulkan::Swapchain& swapchain) const;
+        vulkan::RenderPass                         create_render_pass() const;
+        vulkan::Pipeline                           create_pipeline() const;
+        Deleter<VkShaderModule>                    create_shader_module(const char* name) const;
+        std::vector<vulkan::Framebuffer>           create_framebuffers(const std::vector<vulkan::ImageView>& image_views, vulkan::Extent2D extent) const;
+        std::vector<View>                          create_views(const std::vector<ViewSettings>& view_settings) const;
+        vulkan::DescriptorSetCache                 create_descriptor_set_cache() const;
+        std::optional<vulkan::QueryPool>           create_query_pool(bool pipeline_statistics) const;
+
+        MeshHandle                                 add_mesh(Mesh&& mesh);
+        void                                       record(View& view, uint32_t image_index, VkQueryPool view_query_pool);
+
+        // Measure input latency of every frame up to the value, blocking until it completes
+        void                                       record_completed_frames(uint64_t value);
+
+        // Waits until the deadline, measuring the frames that complete meanwhile
+        void                                       wait_for_frames(FrameLimiter::Clock::time_point deadline);
+    };
+
+}
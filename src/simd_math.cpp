@@ -0,0 +1,459 @@
+#include "simd_math.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(STIRLING_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Kernels of higher levels are compiled per function, so the rest of the build keeps its baseline
+#if defined(STIRLING_X86) && (defined(__GNUC__) || defined(__clang__))
+#define STIRLING_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define STIRLING_TARGET_AVX2
+#endif
+
+namespace stirling {
+
+    namespace {
+
+        using MultiplyMatrices = void (*)(const glm::mat4*, const glm::mat4*, glm::mat4*, size_t, size_t);
+        using CullSpheres = size_t (*)(const Frustum&, const BoundingSpheres&, size_t, uint32_t, uint32_t*);
+        using CullBoxes = size_t (*)(const Frustum&, const BoundingBoxes&, size_t, uint32_t, uint32_t*);
+
+        struct Kernels {
+            MultiplyMatrices multiply_matrices;
+            CullSpheres      cull_spheres;
+            CullBoxes        cull_boxes;
+        };
+
+        // The lhs stride is 0 when every product shares one lhs matrix
+
+        void multiply_matrices_scalar(
+            const glm::mat4* lhs,
+            const glm::mat4* rhs,
+            glm::mat4*       results,
+            size_t           count,
+            size_t           lhs_stride) {
+
+            for (size_t i = 0; i < count; ++i) {
+                results[i] = lhs[i * lhs_stride] * rhs[i];
+            }
+        }
+
+        size_t cull_spheres_scalar(
+            const Frustum&         frustum,
+            const BoundingSpheres& spheres,
+            size_t                 count,
+            uint32_t               first_index,
+            uint32_t*              visible_indices) {
+
+            size_t visible_count = 0;
+            for (size_t i = 0; i < count; ++i) {
+                bool visible = true;
+                for (const auto& plane : frustum.planes) {
+                    const auto distance = plane.x * spheres.center_x[i] + plane.y * spheres.center_y[i] +
+                                          plane.z * spheres.center_z[i] + plane.w;
+                    visible &= distance >= -spheres.radius[i];
+                }
+                visible_indices[visible_count] = first_index + static_cast<uint32_t>(i);
+                visible_count += visible;
+            }
+            return visible_count;
+        }
+
+        size_t cull_boxes_scalar(
+            const Frustum&       frustum,
+            const BoundingBoxes& boxes,
+            size_t               count,
+            uint32_t             first_index,
+            uint32_t*            visible_indices) {
+
+            size_t visible_count = 0;
+            for (size_t i = 0; i < count; ++i) {
+                bool visible = true;
+                for (const auto& plane : frustum.planes) {
+                    // Distance of the box corner furthest along the plane normal
+                    const auto distance = plane.x * boxes.center_x[i] + plane.y * boxes.center_y[i] +
+                                          plane.z * boxes.center_z[i] + plane.w;
+                    const auto reach = std::abs(plane.x) * boxes.extent_x[i] + std::abs(plane.y) * boxes.extent_y[i] +
+                                       std::abs(plane.z) * boxes.extent_z[i];
+                    visible &= distance + reach >= 0.0f;
+                }
+                visible_indices[visible_count] = first_index + static_cast<uint32_t>(i);
+                visible_count += visible;
+            }
+            return visible_count;
+        }
+
+#ifdef STIRLING_X86
+
+        // Appends the indices of the set bits of a lane mask
+        inline size_t append_visible(uint32_t mask, uint32_t base_index, uint32_t* visible_indices) {
+            size_t count = 0;
+            while (mask != 0) {
+                uint32_t lane = 0;
+                while (!(mask & (1u << lane))) ++lane;
+                visible_indices[count++] = base_index + lane;
+                mask &= mask - 1;
+            }
+            return count;
+        }
+
+        void multiply_matrices_sse(
+            const glm::mat4* lhs,
+            const glm::mat4* rhs,
+            glm::mat4*       results,
+            size_t           count,
+            size_t           lhs_stride) {
+
+            for (size_t i = 0; i < count; ++i) {
+                const auto l = &lhs[i * lhs_stride][0][0];
+                const auto r = &rhs[i][0][0];
+                const auto l0 = _mm_loadu_ps(l);
+                const auto l1 = _mm_loadu_ps(l + 4);
+                const auto l2 = _mm_loadu_ps(l + 8);
+                const auto l3 = _mm_loadu_ps(l + 12);
+
+                // Both inputs are loaded before storing, so results may alias them
+                __m128 columns[4];
+                for (int j = 0; j < 4; ++j) {
+                    auto column = _mm_mul_ps(l0, _mm_set1_ps(r[j * 4 + 0]));
+                    column = _mm_add_ps(column, _mm_mul_ps(l1, _mm_set1_ps(r[j * 4 + 1])));
+                    column = _mm_add_ps(column, _mm_mul_ps(l2, _mm_set1_ps(r[j * 4 + 2])));
+                    column = _mm_add_ps(column, _mm_mul_ps(l3, _mm_set1_ps(r[j * 4 + 3])));
+                    columns[j] = column;
+                }
+
+                const auto out = &results[i][0][0];
+                for (int j = 0; j < 4; ++j) {
+                    _mm_storeu_ps(out + j * 4, columns[j]);
+                }
+            }
+        }
+
+        size_t cull_spheres_sse(
+            const Frustum&         frustum,
+            const BoundingSpheres& spheres,
+            size_t                 count,
+            uint32_t               first_index,
+            uint32_t*              visible_indices) {
+
+            size_t visible_count = 0;
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const auto x = _mm_loadu_ps(spheres.center_x + i);
+                const auto y = _mm_loadu_ps(spheres.center_y + i);
+                const auto z = _mm_loadu_ps(spheres.center_z + i);
+                const auto negative_radius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius + i));
+
+                auto visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (const auto& plane : frustum.planes) {
+                    auto distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+                    visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negative_radius));
+                }
+
+                const auto mask = static_cast<uint32_t>(_mm_movemask_ps(visible));
+                visible_count += append_visible(mask, first_index + static_cast<uint32_t>(i), visible_indices + visible_count);
+            }
+
+            const BoundingSpheres tail = {
+                spheres.center_x + i, spheres.center_y + i, spheres.center_z + i, spheres.radius + i
+            };
+            return visible_count + cull_spheres_scalar(
+                frustum, tail, count - i, first_index + static_cast<uint32_t>(i), visible_indices + visible_count);
+        }
+
+        size_t cull_boxes_sse(
+            const Frustum&       frustum,
+            const BoundingBoxes& boxes,
+            size_t               count,
+            uint32_t             first_index,
+            uint32_t*            visible_indices) {
+
+            const auto sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+            size_t visible_count = 0;
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const auto x = _mm_loadu_ps(boxes.center_x + i);
+                const auto y = _mm_loadu_ps(boxes.center_y + i);
+                const auto z = _mm_loadu_ps(boxes.center_z + i);
+                const auto ex = _mm_loadu_ps(boxes.extent_x + i);
+                const auto ey = _mm_loadu_ps(boxes.extent_y + i);
+                const auto ez = _mm_loadu_ps(boxes.extent_z + i);
+
+                auto visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (const auto& plane : frustum.planes) {
+                    const auto nx = _mm_set1_ps(plane.x);
+                    const auto ny = _mm_set1_ps(plane.y);
+                    const auto nz = _mm_set1_ps(plane.z);
+
+                    auto distance = _mm_add_ps(_mm_mul_ps(x, nx), _mm_set1_ps(plane.w));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(y, ny));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(z, nz));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(ex, _mm_and_ps(nx, sign_mask)));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(ey, _mm_and_ps(ny, sign_mask)));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(ez, _mm_and_ps(nz, sign_mask)));
+                    visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+                }
+
+                const auto mask = static_cast<uint32_t>(_mm_movemask_ps(visible));
+                visible_count += append_visible(mask, first_index + static_cast<uint32_t>(i), visible_indices + visible_count);
+            }
+
+            const BoundingBoxes tail = {
+                boxes.center_x + i, boxes.center_y + i, boxes.center_z + i,
+                boxes.extent_x + i, boxes.extent_y + i, boxes.extent_z + i
+            };
+            return visible_count + cull_boxes_scalar(
+                frustum, tail, count - i, first_index + static_cast<uint32_t>(i), visible_indices + visible_count);
+        }
+
+        STIRLING_TARGET_AVX2
+        void multiply_matrices_avx2(
+            const glm::mat4* lhs,
+            const glm::mat4* rhs,
+            glm::mat4*       results,
+            size_t           count,
+            size_t           lhs_stride) {
+
+            for (size_t i = 0; i < count; ++i) {
+                // Every lhs column in both lanes, so two result columns are built at once
+                const auto l = &lhs[i * lhs_stride][0][0];
+                const auto l0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l));
+                const auto l1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l + 4));
+                const auto l2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l + 8));
+                const auto l3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l + 12));
+
+                const auto r = &rhs[i][0][0];
+                const auto r01 = _mm256_loadu_ps(r);
+                const auto r23 = _mm256_loadu_ps(r + 8);
+
+                auto c01 = _mm256_mul_ps(l0, _mm256_permute_ps(r01, 0x00));
+                c01 = _mm256_fmadd_ps(l1, _mm256_permute_ps(r01, 0x55), c01);
+                c01 = _mm256_fmadd_ps(l2, _mm256_permute_ps(r01, 0xAA), c01);
+                c01 = _mm256_fmadd_ps(l3, _mm256_permute_ps(r01, 0xFF), c01);
+
+                auto c23 = _mm256_mul_ps(l0, _mm256_permute_ps(r23, 0x00));
+                c23 = _mm256_fmadd_ps(l1, _mm256_permute_ps(r23, 0x55), c23);
+                c23 = _mm256_fmadd_ps(l2, _mm256_permute_ps(r23, 0xAA), c23);
+                c23 = _mm256_fmadd_ps(l3, _mm256_permute_ps(r23, 0xFF), c23);
+
+                const auto out = &results[i][0][0];
+                _mm256_storeu_ps(out, c01);
+                _mm256_storeu_ps(out + 8, c23);
+            }
+        }
+
+        STIRLING_TARGET_AVX2
+        size_t cull_spheres_avx2(
+            const Frustum&         frustum,
+            const BoundingSpheres& spheres,
+            size_t                 count,
+            uint32_t               first_index,
+            uint32_t*              visible_indices) {
+
+            size_t visible_count = 0;
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const auto x = _mm256_loadu_ps(spheres.center_x + i);
+                const auto y = _mm256_loadu_ps(spheres.center_y + i);
+                const auto z = _mm256_loadu_ps(spheres.center_z + i);
+                const auto negative_radius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(spheres.radius + i));
+
+                auto visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (const auto& plane : frustum.planes) {
+                    auto distance = _mm256_fmadd_ps(x, _mm256_set1_ps(plane.x), _mm256_set1_ps(plane.w));
+                    distance = _mm256_fmadd_ps(y, _mm256_set1_ps(plane.y), distance);
+                    distance = _mm256_fmadd_ps(z, _mm256_set1_ps(plane.z), distance);
+                    visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, negative_radius, _CMP_GE_OQ));
+                }
+
+                const auto mask = static_cast<uint32_t>(_mm256_movemask_ps(visible));
+                visible_count += append_visible(mask, first_index + static_cast<uint32_t>(i), visible_indices + visible_count);
+            }
+
+            const BoundingSpheres tail = {
+                spheres.center_x + i, spheres.center_y + i, spheres.center_z + i, spheres.radius + i
+            };
+            return visible_count + cull_spheres_scalar(
+                frustum, tail, count - i, first_index + static_cast<uint32_t>(i), visible_indices + visible_count);
+        }
+
+        STIRLING_TARGET_AVX2
+        size_t cull_boxes_avx2(
+            const Frustum&       frustum,
+            const BoundingBoxes& boxes,
+            size_t               count,
+            uint32_t             first_index,
+            uint32_t*            visible_indices) {
+
+            const auto sign_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+            size_t visible_count = 0;
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const auto x = _mm256_loadu_ps(boxes.center_x + i);
+                const auto y = _mm256_loadu_ps(boxes.center_y + i);
+                const auto z = _mm256_loadu_ps(boxes.center_z + i);
+                const auto ex = _mm256_loadu_ps(boxes.extent_x + i);
+                const auto ey = _mm256_loadu_ps(boxes.extent_y + i);
+                const auto ez = _mm256_loadu_ps(boxes.extent_z + i);
+
+                auto visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (const auto& plane : frustum.planes) {
+                    const auto nx = _mm256_set1_ps(plane.x);
+                    const auto ny = _mm256_set1_ps(plane.y);
+                    const auto nz = _mm256_set1_ps(plane.z);
+
+                    auto distance = _mm256_fmadd_ps(x, nx, _mm256_set1_ps(plane.w));
+                    distance = _mm256_fmadd_ps(y, ny, distance);
+                    distance = _mm256_fmadd_ps(z, nz, distance);
+                    distance = _mm256_fmadd_ps(ex, _mm256_and_ps(nx, sign_mask), distance);
+                    distance = _mm256_fmadd_ps(ey, _mm256_and_ps(ny, sign_mask), distance);
+                    distance = _mm256_fmadd_ps(ez, _mm256_and_ps(nz, sign_mask), distance);
+                    visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+                }
+
+                const auto mask = static_cast<uint32_t>(_mm256_movemask_ps(visible));
+                visible_count += append_visible(mask, first_index + static_cast<uint32_t>(i), visible_indices + visible_count);
+            }
+
+            const BoundingBoxes tail = {
+                boxes.center_x + i, boxes.center_y + i, boxes.center_z + i,
+                boxes.extent_x + i, boxes.extent_y + i, boxes.extent_z + i
+            };
+            return visible_count + cull_boxes_scalar(
+                frustum, tail, count - i, first_index + static_cast<uint32_t>(i), visible_indices + visible_count);
+        }
+
+        bool supports_avx2() {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER)
+            // The OS must also save the upper halves of the ymm registers
+            int info[4];
+            __cpuid(info, 1);
+            const bool fma = (info[2] & (1 << 12)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (!fma || !osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return false;
+#endif
+        }
+
+#endif
+
+        constexpr Kernels kernels[] = {
+            { multiply_matrices_scalar, cull_spheres_scalar, cull_boxes_scalar },
+#ifdef STIRLING_X86
+            { multiply_matrices_sse,    cull_spheres_sse,    cull_boxes_sse },
+            { multiply_matrices_avx2,   cull_spheres_avx2,   cull_boxes_avx2 },
+#endif
+        };
+
+        SimdLevel detect_simd_level() {
+#ifdef STIRLING_X86
+            return supports_avx2() ? SimdLevel::avx2 : SimdLevel::sse;
+#else
+            return SimdLevel::scalar;
+#endif
+        }
+
+        const SimdLevel supported_level = detect_simd_level();
+        std::atomic<uint32_t> current_level{static_cast<uint32_t>(supported_level)};
+
+        inline const Kernels& get_kernels() {
+            return kernels[current_level.load(std::memory_order_relaxed)];
+        }
+
+    }
+
+    SimdLevel get_supported_simd_level() {
+        return supported_level;
+    }
+
+    SimdLevel get_simd_level() {
+        return static_cast<SimdLevel>(current_level.load(std::memory_order_relaxed));
+    }
+
+    void set_simd_level(SimdLevel level) {
+        current_level = std::min(static_cast<uint32_t>(level), static_cast<uint32_t>(supported_level));
+    }
+
+    const char* get_simd_level_name(SimdLevel level) {
+        switch (level) {
+        case SimdLevel::scalar: return "scalar";
+        case SimdLevel::sse:    return "SSE";
+        case SimdLevel::avx2:   return "AVX2";
+        }
+        return "unknown";
+    }
+
+    Frustum make_frustum(const glm::mat4& view_projection) {
+        // Rows of the transform, glm matrices are indexed by column
+        const auto row = [&view_projection](int i) {
+            return glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]);
+        };
+        const auto r0 = row(0);
+        const auto r1 = row(1);
+        const auto r2 = row(2);
+        const auto r3 = row(3);
+
+        Frustum frustum = {{
+            r3 + r0, r3 - r0,
+            r3 + r1, r3 - r1,
+            r3 + r2, r3 - r2
+        }};
+
+        // Normalized planes give distances in world units, which sphere radii need
+        for (auto& plane : frustum.planes) {
+            const auto length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f) {
+                plane /= length;
+            }
+        }
+        return frustum;
+    }
+
+    void multiply_matrices(const glm::mat4* lhs, const glm::mat4* rhs, glm::mat4* results, size_t count) {
+        get_kernels().multiply_matrices(lhs, rhs, results, count, 1);
+    }
+
+    void multiply_matrices(const glm::mat4& lhs, const glm::mat4* rhs, glm::mat4* results, size_t count) {
+        // Every product reads lhs, which the first result would overwrite if they alias
+        const auto shared_lhs = lhs;
+        get_kernels().multiply_matrices(&shared_lhs, rhs, results, count, 0);
+    }
+
+    size_t cull_spheres(
+        const Frustum&         frustum,
+        const BoundingSpheres& spheres,
+        size_t                 count,
+        uint32_t               first_index,
+        uint32_t*              visible_indices) {
+
+        return get_kernels().cull_spheres(frustum, spheres, count, first_index, visible_indices);
+    }
+
+    size_t cull_boxes(
+        const Frustum&       frustum,
+        const BoundingBoxes& boxes,
+        size_t               count,
+        uint32_t             first_index,
+        uint32_t*            visible_indices) {
+
+        return get_kernels().cull_boxes(frustum, boxes, count, first_index, visible_indices);
+    }
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define STIRLING_X86 1
+#include <immintrin.h>
+#endif
+
+namespace stirling {
+
+    // Instruction sets of the batched kernels, picked at runtime from what the CPU supports
+    enum class SimdLevel : uint32_t {
+        scalar = 0,
+        sse    = 1, // SSE2, always available on x86-64
+        avx2   = 2  // AVX2 with FMA
+    };
+
+    SimdLevel get_supported_simd_level();
+    SimdLevel get_simd_level();
+
+    // Forces a lower level, for comparing kernels, requests above the supported level are clamped
+    void set_simd_level(SimdLevel level);
+
+    const char* get_simd_level_name(SimdLevel level);
+
+    // Planes point inwards, a point p is inside when dot(plane.xyz, p) + plane.w >= 0 for all six
+    struct Frustum {
+        glm::vec4 planes[6];
+    };
+
+    // Extracts normalized left, right, bottom, top, near and far planes from a clip space transform.
+    // The near plane uses the -w <= z convention of glm, which also bounds a 0 <= z projection.
+    Frustum make_frustum(const glm::mat4& view_projection);
+
+    // Structure of arrays views of bounding volumes, every array holds one value per object
+    struct BoundingSpheres {
+        const float* center_x;
+        const float* center_y;
+        const float* center_z;
+        const float* radius;
+    };
+
+    struct BoundingBoxes {
+        const float* center_x;
+        const float* center_y;
+        const float* center_z;
+        const float* extent_x;
+        const float* extent_y;
+        const float* extent_z;
+    };
+
+    // Matrices stay arrays of glm::mat4 rather than structure of arrays like the bounding volumes.
+    // A column times broadcast product already fills every lane, and transforms, draw constants and
+    // uniform buffers all consume whole matrices, so splitting them would add a transpose per use.
+
+    // results[i] = lhs[i] * rhs[i], results may alias either input
+    void multiply_matrices(const glm::mat4* lhs, const glm::mat4* rhs, glm::mat4* results, size_t count);
+
+    // results[i] = lhs * rhs[i], e.g. world-view-projection matrices from one view-projection,
+    // results may alias lhs or rhs
+    void multiply_matrices(const glm::mat4& lhs, const glm::mat4* rhs, glm::mat4* results, size_t count);
+
+    // Write the indices of volumes intersecting the frustum, offset by first_index, and return how
+    // many were written. visible_indices must hold count elements.
+    size_t cull_spheres(
+        const Frustum&         frustum,
+        const BoundingSpheres& spheres,
+        size_t                 count,
+        uint32_t               first_index,
+        uint32_t*              visible_indices);
+
+    size_t cull_boxes(
+        const Frustum&       frustum,
+        const BoundingBoxes& boxes,
+        size_t               count,
+        uint32_t             first_index,
+        uint32_t*            visible_indices);
+
+    // Single product for call sites that cannot batch, SSE is part of the x86-64 baseline so this
+    // needs no dispatch
+    inline glm::mat4 multiply_matrix(const glm::mat4& lhs, const glm::mat4& rhs) {
+#ifdef STIRLING_X86
+        const auto l = &lhs[0][0];
+        const auto r = &rhs[0][0];
+        const auto l0 = _mm_loadu_ps(l);
+        const auto l1 = _mm_loadu_ps(l + 4);
+        const auto l2 = _mm_loadu_ps(l + 8);
+        const auto l3 = _mm_loadu_ps(l + 12);
+
+        // Column j of the product is lhs weighted by column j of rhs
+        glm::mat4 result;
+        const auto out = &result[0][0];
+        for (int j = 0; j < 4; ++j) {
+            auto column = _mm_mul_ps(l0, _mm_set1_ps(r[j * 4 + 0]));
+            column = _mm_add_ps(column, _mm_mul_ps(l1, _mm_set1_ps(r[j * 4 + 1])));
+            column = _mm_add_ps(column, _mm_mul_ps(l2, _mm_set1_ps(r[j * 4 + 2])));
+            column = _mm_add_ps(column, _mm_mul_ps(l3, _mm_set1_ps(r[j * 4 + 3])));
+            _mm_storeu_ps(out + j * 4, column);
+        }
+        return result;
+#else
+        return lhs * rhs;
+#endif
+    }
+
+}
@@ -0,0 +1,294 @@
+#include "texture.hpp"
+#include "vulkan/staging_buffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace stirling {
+
+    uint32_t get_mip_level_count(VkExtent2D extent) {
+        return static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1;
+    }
+
+    TextureLoader::TextureLoader(
+        const vulkan::PhysicalDevice& physical_device,
+        const vulkan::Device&         device,
+        const vulkan::CommandPool&    command_pool,
+        const vulkan::Queue&          queue) :
+
+        physical_device (physical_device),
+        device          (device),
+        command_pool    (command_pool),
+        queue           (queue),
+        sampler_cache   (device.create_sampler_cache()),
+        fence_pool      (device.create_fence_pool()) {
+    }
+
+    VkSampler TextureLoader::get_sampler(const vulkan::SamplerCreateInfo& create_info) {
+        return sampler_cache.get(create_info);
+    }
+
+    Texture TextureLoader::load(const TextureCreateInfo& create_info) {
+        // Blitting mip levels requires blit and linear filtering support for the format
+        constexpr VkFormatFeatureFlags mip_blit_features =
+            VK_FORMAT_FEATURE_BLIT_SRC_BIT |
+            VK_FORMAT_FEATURE_BLIT_DST_BIT |
+            VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        if (create_info.generate_mipmaps &&
+            (physical_device.get_format_properties(create_info.format).optimalTilingFeatures & mip_blit_features) != mip_blit_features) {
+            throw "Texture format does not support linear blitting.";
+        }
+
+        const auto mip_levels = create_info.generate_mipmaps ? get_mip_level_count(create_info.extent) : 1;
+
+        // Create image
+        auto image = device.create_image({
+            .image_type     = VK_IMAGE_TYPE_2D,
+            .format         = create_info.format,
+            .extent         = { create_info.extent.width, create_info.extent.height, 1 },
+            .mip_levels     = mip_levels,
+            .array_layers   = 1,
+            .samples        = VK_SAMPLE_COUNT_1_BIT,
+            .tiling         = VK_IMAGE_TILING_OPTIMAL,
+            .usage          = VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+                            | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+                            | VK_IMAGE_USAGE_SAMPLED_BIT,
+            .sharing_mode   = VK_SHARING_MODE_EXCLUSIVE,
+            .initial_layout = VK_IMAGE_LAYOUT_UNDEFINED
+        });
+
+        // Allocate and bind device local memory for image
+        const auto memory_requirements = image.get_memory_requirements();
+        auto memory = device.allocate_memory({
+            .allocation_size   = memory_requirements.size,
+            .memory_type_index = physical_device.find_memory_type(
+                memory_requirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+            )
+        });
+        image.bind(memory, 0);
+
+        // Copy texel data to staging buffer
+        const vulkan::StagingBuffer staging_buffer{create_info.size, physical_device, device};
+        staging_buffer.map().copy(create_info.data, create_info.size);
+
+        // Record upload and mip generation into a single command buffer
+        const auto command_buffer = command_pool.allocate_command_buffers({
+            .level                = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .command_buffer_count = 1
+        })[0];
+
+        command_buffer
+            .begin({{
+                .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+            }})
+            .pipeline_barrier(
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, {}, {},
+                {
+                    {
+                        .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                        .srcAccessMask       = 0,
+                        .dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+                        .oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED,
+                        .newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .image               = image,
+                        .subresourceRange    = {
+                            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                            .baseMipLevel   = 0,
+                            .levelCount     = mip_levels,
+                            .baseArrayLayer = 0,
+                            .layerCount     = 1
+                        }
+                    }
+                }
+            )
+            .copy_buffer_to_image(
+                staging_buffer,
+                image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                {
+                    {
+                        .bufferOffset      = 0,
+                        .bufferRowLength   = 0,
+                        .bufferImageHeight = 0,
+                        .imageSubresource  = {
+                            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                            .mipLevel       = 0,
+                            .baseArrayLayer = 0,
+                            .layerCount     = 1
+                        },
+                        .imageOffset       = { 0, 0, 0 },
+                        .imageExtent       = { create_info.extent.width, create_info.extent.height, 1 }
+                    }
+                }
+            );
+
+        generate_mipmaps(command_buffer, image, create_info.extent, mip_levels);
+
+        command_buffer.end();
+
+        // Wait for this upload only, rather than for all work on the queue
+        const auto fence = fence_pool.acquire();
+        queue.submit({
+            {{
+                .command_buffers = {
+                    command_buffer
+                },
+            }}
+        }, fence);
+
+        fence_pool.wait({ fence });
+        fence_pool.release(fence);
+
+        // Create image view over the whole mip chain
+        auto view = device.create_image_view({
+            .image      = image,
+            .view_type  = VK_IMAGE_VIEW_TYPE_2D,
+            .format     = create_info.format,
+            .components = {
+                .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .a = VK_COMPONENT_SWIZZLE_IDENTITY
+            },
+            .subresource_range = {
+                .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel   = 0,
+                .levelCount     = mip_levels,
+                .baseArrayLayer = 0,
+                .layerCount     = 1
+            }
+        });
+
+        return {
+            std::move(image),
+            std::move(memory),
+            std::move(view),
+            sampler_cache.get(create_info.sampler),
+            create_info.format,
+            create_info.extent,
+            mip_levels
+        };
+    }
+
+    void TextureLoader::generate_mipmaps(
+        const vulkan::CommandBuffer& command_buffer,
+        VkImage                      image,
+        VkExtent2D                   extent,
+        uint32_t                     mip_levels) const {
+
+        const auto barrier = [image](
+            uint32_t      mip_level,
+            VkAccessFlags src_access_mask,
+            VkAccessFlags dst_access_mask,
+            VkImageLayout old_layout,
+            VkImageLayout new_layout) -> VkImageMemoryBarrier {
+
+            return {
+                .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .srcAccessMask       = src_access_mask,
+                .dstAccessMask       = dst_access_mask,
+                .oldLayout           = old_layout,
+                .newLayout           = new_layout,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image               = image,
+                .subresourceRange    = {
+                    .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .baseMipLevel   = mip_level,
+                    .levelCount     = 1,
+                    .baseArrayLayer = 0,
+                    .layerCount     = 1
+                }
+            };
+        };
+
+        auto mip_width = static_cast<int32_t>(extent.width);
+        auto mip_height = static_cast<int32_t>(extent.height);
+
+        for (uint32_t i = 1; i < mip_levels; ++i) {
+            const auto next_width = std::max(mip_width / 2, 1);
+            const auto next_height = std::max(mip_height / 2, 1);
+
+            // Downsample previous level into this one, then hand the previous level to the shaders
+            command_buffer
+                .pipeline_barrier(
+                    VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    0, {}, {},
+                    {
+                        barrier(
+                            i - 1,
+                            VK_ACCESS_TRANSFER_WRITE_BIT,
+                            VK_ACCESS_TRANSFER_READ_BIT,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                        )
+                    }
+                )
+                .blit_image(
+                    image,
+                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                    image,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    {
+                        {
+                            .srcSubresource = {
+                                .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                                .mipLevel       = i - 1,
+                                .baseArrayLayer = 0,
+                                .layerCount     = 1
+                            },
+                            .srcOffsets     = { { 0, 0, 0 }, { mip_width, mip_height, 1 } },
+                            .dstSubresource = {
+                                .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                                .mipLevel       = i,
+                                .baseArrayLayer = 0,
+                                .layerCount     = 1
+                            },
+                            .dstOffsets     = { { 0, 0, 0 }, { next_width, next_height, 1 } }
+                        }
+                    },
+                    VK_FILTER_LINEAR
+                )
+                .pipeline_barrier(
+                    VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                    0, {}, {},
+                    {
+                        barrier(
+                            i - 1,
+                            VK_ACCESS_TRANSFER_READ_BIT,
+                            VK_ACCESS_SHADER_READ_BIT,
+                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                        )
+                    }
+                );
+
+            mip_width = next_width;
+            mip_height = next_height;
+        }
+
+        // Last level was only ever written to
+        command_buffer.pipeline_barrier(
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            0, {}, {},
+            {
+                barrier(
+                    mip_levels - 1,
+                    VK_ACCESS_TRANSFER_WRITE_BIT,
+                    VK_ACCESS_SHADER_READ_BIT,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                )
+            }
+        );
+    }
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "vulkan/command_pool.hpp"
+#include "vulkan/device.hpp"
+#include "vulkan/device_memory.hpp"
+#include "vulkan/fence_pool.hpp"
+#include "vulkan/image.hpp"
+#include "vulkan/physical_device.hpp"
+#include "vulkan/queue.hpp"
+#include "vulkan/sampler.hpp"
+#include "vulkan/vulkan.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace stirling {
+
+    struct TextureCreateInfo {
+        VkFormat                  format;
+        VkExtent2D                extent;
+        bool                      generate_mipmaps;
+        const void*               data;
+        size_t                    size;
+        vulkan::SamplerCreateInfo sampler;
+    };
+
+    struct Texture {
+        vulkan::Image        image;
+        vulkan::DeviceMemory memory;
+        vulkan::ImageView    view;
+        VkSampler            sampler;
+        VkFormat             format;
+        VkExtent2D           extent;
+        uint32_t             mip_levels;
+    };
+
+    uint32_t get_mip_level_count(VkExtent2D extent);
+
+    struct TextureLoader {
+        TextureLoader(
+            const vulkan::PhysicalDevice& physical_device,
+            const vulkan::Device&         device,
+            const vulkan::CommandPool&    command_pool,
+            const vulkan::Queue&          queue);
+
+        Texture load(const TextureCreateInfo& create_info);
+
+        VkSampler get_sampler(const vulkan::SamplerCreateInfo& create_info);
+
+    private:
+        const vulkan::PhysicalDevice& physical_device;
+        const vulkan::Device&         device;
+        const vulkan::CommandPool&    command_pool;
+        const vulkan::Queue&          queue;
+        vulkan::SamplerCache          sampler_cache;
+        vulkan::FencePool             fence_pool;
+
+        void generate_mipmaps(
+            const vulkan::CommandBuffer& command_buffer,
+            VkImage                      image,
+            VkExtent2D                   extent,
+            uint32_t                     mip_levels) const;
+    };
+
+}
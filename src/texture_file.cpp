@@ -0,0 +1,207 @@
+#include "texture_file.hpp"
+#include "file.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace stirling {
+
+    namespace {
+
+        constexpr uint8_t ktx2_identifier[12] = {
+            0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+        };
+
+        constexpr uint8_t dds_magic[4] = { 'D', 'D', 'S', ' ' };
+
+        template<typename T>
+        inline T read(const FileView& file, size_t offset) {
+            if (offset + sizeof(T) > file.size()) throw "Malformed texture file.";
+            T value;
+            memcpy(&value, file.data() + offset, sizeof(T));
+            return value;
+        }
+
+        inline bool has_magic(const FileView& file, const uint8_t* magic, size_t size) {
+            return file.size() >= size && memcmp(file.data(), magic, size) == 0;
+        }
+
+        constexpr uint32_t make_four_cc(char a, char b, char c, char d) {
+            return static_cast<uint32_t>(a)
+                | (static_cast<uint32_t>(b) << 8)
+                | (static_cast<uint32_t>(c) << 16)
+                | (static_cast<uint32_t>(d) << 24);
+        }
+
+        VkFormat get_four_cc_format(uint32_t four_cc) {
+            switch (four_cc) {
+            case make_four_cc('D', 'X', 'T', '1'): return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+            case make_four_cc('D', 'X', 'T', '3'): return VK_FORMAT_BC2_UNORM_BLOCK;
+            case make_four_cc('D', 'X', 'T', '5'): return VK_FORMAT_BC3_UNORM_BLOCK;
+            case make_four_cc('A', 'T', 'I', '1'):
+            case make_four_cc('B', 'C', '4', 'U'): return VK_FORMAT_BC4_UNORM_BLOCK;
+            case make_four_cc('A', 'T', 'I', '2'):
+            case make_four_cc('B', 'C', '5', 'U'): return VK_FORMAT_BC5_UNORM_BLOCK;
+            default: throw "Unsupported DDS pixel format.";
+            }
+        }
+
+        VkFormat get_dxgi_format(uint32_t dxgi_format) {
+            switch (dxgi_format) {
+            case 28: return VK_FORMAT_R8G8B8A8_UNORM;
+            case 29: return VK_FORMAT_R8G8B8A8_SRGB;
+            case 71: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+            case 72: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+            case 74: return VK_FORMAT_BC2_UNORM_BLOCK;
+            case 75: return VK_FORMAT_BC2_SRGB_BLOCK;
+            case 77: return VK_FORMAT_BC3_UNORM_BLOCK;
+            case 78: return VK_FORMAT_BC3_SRGB_BLOCK;
+            case 80: return VK_FORMAT_BC4_UNORM_BLOCK;
+            case 81: return VK_FORMAT_BC4_SNORM_BLOCK;
+            case 83: return VK_FORMAT_BC5_UNORM_BLOCK;
+            case 84: return VK_FORMAT_BC5_SNORM_BLOCK;
+            case 87: return VK_FORMAT_B8G8R8A8_UNORM;
+            case 91: return VK_FORMAT_B8G8R8A8_SRGB;
+            case 95: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+            case 96: return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+            case 98: return VK_FORMAT_BC7_UNORM_BLOCK;
+            case 99: return VK_FORMAT_BC7_SRGB_BLOCK;
+            default: throw "Unsupported DXGI format.";
+            }
+        }
+
+        // Size in bytes of one 4x4 block, or of one texel for uncompressed formats
+        uint32_t get_dds_block_size(VkFormat format) {
+            switch (format) {
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+            case VK_FORMAT_BC4_SNORM_BLOCK:
+                return 8;
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+                return 4;
+            default:
+                return 16;
+            }
+        }
+
+        inline bool is_block_compressed(VkFormat format) {
+            return format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK;
+        }
+
+        inline VkExtent2D get_level_extent(VkExtent2D extent, uint32_t level) {
+            return {
+                std::max(extent.width >> level, 1u),
+                std::max(extent.height >> level, 1u)
+            };
+        }
+
+        // Levels halve down to 1x1, so a full chain has floor(log2(max(width, height))) + 1 levels
+        inline uint32_t get_max_level_count(VkExtent2D extent) {
+            uint32_t level_count = 0;
+            for (auto size = std::max(extent.width, extent.height); size > 0; size >>= 1) {
+                ++level_count;
+            }
+            return level_count;
+        }
+
+    }
+
+    TextureFile parse_ktx2(FileView&& file) {
+        if (!has_magic(file, ktx2_identifier, sizeof(ktx2_identifier))) throw "Not a KTX2 file.";
+
+        const auto vk_format = read<uint32_t>(file, 12);
+        const auto pixel_width = read<uint32_t>(file, 20);
+        const auto pixel_height = read<uint32_t>(file, 24);
+        const auto pixel_depth = read<uint32_t>(file, 28);
+        const auto layer_count = read<uint32_t>(file, 32);
+        const auto face_count = read<uint32_t>(file, 36);
+        const auto level_count = std::max(read<uint32_t>(file, 40), 1u);
+        const auto supercompression_scheme = read<uint32_t>(file, 44);
+
+        if (vk_format == VK_FORMAT_UNDEFINED) throw "Basis Universal KTX2 textures are not supported.";
+        if (supercompression_scheme != 0) throw "Supercompressed KTX2 textures are not supported.";
+        if (pixel_depth > 1 || layer_count > 1 || face_count != 1) throw "Only 2D KTX2 textures are supported.";
+
+        const VkExtent2D extent = { pixel_width, pixel_height };
+        if (pixel_width == 0 || pixel_height == 0 || level_count > get_max_level_count(extent)) throw "Malformed texture file.";
+
+        // Level index follows the 80 byte header and section index
+        std::vector<TextureLevel> levels;
+        levels.reserve(level_count);
+        for (uint32_t level = 0; level < level_count; ++level) {
+            const size_t level_index = 80 + level * 24;
+            const auto byte_offset = read<uint64_t>(file, level_index);
+            const auto byte_length = read<uint64_t>(file, level_index + 8);
+            if (byte_offset > file.size() || byte_length > file.size() - byte_offset) throw "Malformed texture file.";
+
+            levels.push_back({
+                .offset = static_cast<size_t>(byte_offset),
+                .size   = static_cast<size_t>(byte_length),
+                .extent = get_level_extent(extent, level)
+            });
+        }
+
+        return {
+            .format = static_cast<VkFormat>(vk_format),
+            .extent = extent,
+            .levels = std::move(levels),
+            .file   = std::move(file)
+        };
+    }
+
+    TextureFile parse_dds(FileView&& file) {
+        if (file.size() < 128 || !has_magic(file, dds_magic, sizeof(dds_magic))) throw "Not a DDS file.";
+
+        const auto height = read<uint32_t>(file, 12);
+        const auto width = read<uint32_t>(file, 16);
+        const auto mip_map_count = std::max(read<uint32_t>(file, 28), 1u);
+        const auto four_cc = read<uint32_t>(file, 84);
+
+        // DX10 extension header carries a DXGI format instead of a FourCC
+        const bool dx10 = four_cc == make_four_cc('D', 'X', '1', '0');
+        const auto format = dx10 ? get_dxgi_format(read<uint32_t>(file, 128)) : get_four_cc_format(four_cc);
+
+        const VkExtent2D extent = { width, height };
+        if (width == 0 || height == 0 || mip_map_count > get_max_level_count(extent)) throw "Malformed texture file.";
+
+        const auto block_size = get_dds_block_size(format);
+        const auto block_dimension = is_block_compressed(format) ? 4u : 1u;
+
+        size_t offset = dx10 ? 148 : 128;
+        std::vector<TextureLevel> levels;
+        levels.reserve(mip_map_count);
+        for (uint32_t level = 0; level < mip_map_count; ++level) {
+            const auto level_extent = get_level_extent(extent, level);
+            const size_t size = static_cast<size_t>(block_size)
+                * ((level_extent.width + block_dimension - 1) / block_dimension)
+                * ((level_extent.height + block_dimension - 1) / block_dimension);
+            if (offset + size > file.size()) throw "Malformed texture file.";
+
+            levels.push_back({
+                .offset = offset,
+                .size   = size,
+                .extent = level_extent
+            });
+            offset += size;
+        }
+
+        return {
+            .format = format,
+            .extent = extent,
+            .levels = std::move(levels),
+            .file   = std::move(file)
+        };
+    }
+
+    TextureFile read_texture_file(const char* file_name) {
+        FileView file{file_name};
+        if (has_magic(file, ktx2_identifier, sizeof(ktx2_identifier))) return parse_ktx2(std::move(file));
+        if (has_magic(file, dds_magic, sizeof(dds_magic))) return parse_dds(std::move(file));
+        throw "Unknown texture file format.";
+    }
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "file.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stirling {
+
+    struct TextureLevel {
+        size_t     offset;
+        size_t     size;
+        VkExtent2D extent;
+    };
+
+    // Block-compressed or uncompressed 2D texture as stored on disk. Level 0 is the largest
+    // mip level, and level data is kept in its GPU layout inside the file view so it can be
+    // copied into staging memory without decoding or an intermediate copy.
+    struct TextureFile {
+        VkFormat                  format;
+        VkExtent2D                extent;
+        std::vector<TextureLevel> levels;
+        FileView                  file;
+
+        inline const uint8_t* get_level_data(uint32_t level) const { return file.data() + levels[level].offset; }
+    };
+
+    TextureFile parse_ktx2(FileView&& file);
+    TextureFile parse_dds(FileView&& file);
+
+    // Detects the container from its magic number
+    TextureFile read_texture_file(const char* file_name);
+
+}
@@ -0,0 +1,341 @@
+#include "texture_streamer.hpp"
+
+#include <algorithm>
+
+namespace stirling {
+
+    namespace {
+
+        // Keeps every level offset aligned to the texel block size of any format
+        constexpr VkDeviceSize level_alignment = 16;
+
+        inline VkDeviceSize align_level(VkDeviceSize offset) {
+            return (offset + level_alignment - 1) & ~(level_alignment - 1);
+        }
+
+    }
+
+    TextureStreamer::TextureStreamer(
+        const vulkan::PhysicalDevice& physical_device,
+        const vulkan::Device&         device,
+        const vulkan::CommandPool&    command_pool,
+        const vulkan::Queue&          queue,
+        TextureLoader&                texture_loader,
+        vulkan::DeletionQueue&        deletion_queue,
+        VkDeviceSize                  staging_size) :
+
+        physical_device (physical_device),
+        device          (device),
+        command_pool    (command_pool),
+        queue           (queue),
+        texture_loader  (texture_loader),
+        deletion_queue  (deletion_queue),
+        upload_timeline (device.create_timeline_semaphore()),
+        upload_value    (0),
+        staging_ring    (align_level(staging_size), physical_device, device),
+        staging_mapping (staging_ring.map()),
+        staging_head    (0),
+        staging_tail    (0) {
+    }
+
+    bool TextureStreamer::supports_format(VkFormat format) {
+        auto it = format_support.find(format);
+        if (it == format_support.end()) {
+            const auto format_properties = physical_device.get_format_properties(format);
+            it = format_support.emplace(
+                format,
+                (format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0
+            ).first;
+        }
+        return it->second;
+    }
+
+    std::shared_ptr<StreamingTexture> TextureStreamer::load(
+        const std::vector<const char*>&  file_names,
+        const vulkan::SamplerCreateInfo& sampler) {
+
+        for (const auto file_name : file_names) {
+            auto file = read_texture_file(file_name);
+            if (!supports_format(file.format)) continue;
+
+            const auto mip_levels = static_cast<uint32_t>(file.levels.size());
+
+            // Create image for the whole mip chain up front, levels are filled in as they stream
+            auto image = device.create_image({
+                .image_type     = VK_IMAGE_TYPE_2D,
+                .format         = file.format,
+                .extent         = { file.extent.width, file.extent.height, 1 },
+                .mip_levels     = mip_levels,
+                .array_layers   = 1,
+                .samples        = VK_SAMPLE_COUNT_1_BIT,
+                .tiling         = VK_IMAGE_TILING_OPTIMAL,
+                .usage          = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                .sharing_mode   = VK_SHARING_MODE_EXCLUSIVE,
+                .initial_layout = VK_IMAGE_LAYOUT_UNDEFINED
+            });
+
+            // Allocate and bind device local memory for image
+            const auto memory_requirements = image.get_memory_requirements();
+            auto memory = device.allocate_memory({
+                .allocation_size   = memory_requirements.size,
+                .memory_type_index = physical_device.find_memory_type(
+                    memory_requirements.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+                )
+            });
+            image.bind(memory, 0);
+
+            auto texture = std::make_shared<StreamingTexture>(StreamingTexture {
+                .image          = std::move(image),
+                .memory         = std::move(memory),
+                .sampler        = texture_loader.get_sampler(sampler),
+                .format         = file.format,
+                .extent         = file.extent,
+                .mip_levels     = mip_levels,
+                .resident_level = mip_levels
+            });
+
+            pending_textures.push_back({
+                .texture    = texture,
+                .file       = std::move(file),
+                .next_level = mip_levels
+            });
+
+            return texture;
+        }
+
+        throw "Failed to find a texture file with a supported format.";
+    }
+
+    void TextureStreamer::update(VkDeviceSize budget) {
+        // Publish levels of finished uploads. Uploads complete in submission order, so only a
+        // prefix of them can be finished, and each one extends the resident range of its texture.
+        // A single read of the upload timeline covers every upload in flight.
+        const auto completed_value = upload_timeline.get_value();
+        const auto unfinished = std::find_if(
+            uploads.begin(),
+            uploads.end(),
+            [completed_value](const Upload& upload) { return upload.timeline_value > completed_value; }
+        );
+        for (auto upload = uploads.begin(); upload != unfinished; ++upload) {
+            staging_tail = upload->staging_end;
+            free_command_buffers.push_back(std::move(upload->command_buffer));
+
+            auto& texture = *upload->texture;
+            texture.resident_level = std::min(texture.resident_level, upload->first_level);
+            if (texture.view) {
+                deletion_queue.release(std::move(texture.view));
+            }
+            texture.view = create_view(texture);
+        }
+        uploads.erase(uploads.begin(), unfinished);
+
+        // Submit coarsest remaining levels first until the budget is spent. The first batch of an
+        // update always takes at least one level, so levels larger than the budget or the staging
+        // ring still make progress. Batches after it must fit both.
+        auto remaining = budget;
+        bool submitted = false;
+        while (!pending_textures.empty()) {
+            auto& pending_texture = pending_textures.front();
+
+            const auto batch_limit = std::min(remaining, staging_ring.size());
+            auto first_level = pending_texture.next_level;
+            VkDeviceSize size = 0;
+            while (first_level > 0) {
+                const auto level_size = align_level(pending_texture.file.levels[first_level - 1].size);
+                if (size + level_size > batch_limit && (submitted || size > 0)) break;
+                size += level_size;
+                --first_level;
+            }
+            if (first_level == pending_texture.next_level) break;
+
+            if (!submit_upload(pending_texture, first_level, size)) break;
+            submitted = true;
+            remaining -= std::min(size, remaining);
+
+            if (pending_texture.next_level == 0) {
+                pending_textures.pop_front();
+            }
+        }
+    }
+
+    bool TextureStreamer::is_idle() const {
+        return pending_textures.empty() && uploads.empty();
+    }
+
+    bool TextureStreamer::submit_upload(PendingTexture& pending_texture, uint32_t first_level, VkDeviceSize size) {
+        const auto& file = pending_texture.file;
+        const auto last_level = pending_texture.next_level;
+        const auto level_count = last_level - first_level;
+
+        // Levels larger than the whole ring get a staging buffer of their own
+        std::optional<vulkan::StagingBuffer> staging_buffer;
+        VkDeviceSize staging_offset = 0;
+        if (size > staging_ring.size()) {
+            staging_buffer.emplace(size, physical_device, device);
+        } else {
+            const auto offset = allocate_staging(size);
+            if (!offset) return false;
+            staging_offset = *offset % staging_ring.size();
+        }
+
+        // Copy levels into staging memory straight from the file, no decoding required
+        regions.clear();
+        for (auto level = last_level; level-- > first_level;) {
+            regions.push_back({
+                .bufferOffset      = staging_offset,
+                .bufferRowLength   = 0,
+                .bufferImageHeight = 0,
+                .imageSubresource  = {
+                    .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel       = level,
+                    .baseArrayLayer = 0,
+                    .layerCount     = 1
+                },
+                .imageOffset       = { 0, 0, 0 },
+                .imageExtent       = { file.levels[level].extent.width, file.levels[level].extent.height, 1 }
+            });
+            staging_offset += align_level(file.levels[level].size);
+        }
+
+        const auto copy_levels = [&](vulkan::DeviceMemoryMapping& mapping) {
+            for (const auto& region : regions) {
+                const auto level = region.imageSubresource.mipLevel;
+                mapping.copy(file.get_level_data(level), file.levels[level].size, region.bufferOffset);
+            }
+        };
+        if (staging_buffer) {
+            auto mapping = staging_buffer->map();
+            copy_levels(mapping);
+        } else {
+            copy_levels(staging_mapping);
+        }
+        const VkBuffer source = staging_buffer ? static_cast<VkBuffer>(*staging_buffer) : static_cast<VkBuffer>(staging_ring);
+
+        const VkImageSubresourceRange subresource_range {
+            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel   = first_level,
+            .levelCount     = level_count,
+            .baseArrayLayer = 0,
+            .layerCount     = 1
+        };
+
+        // Command buffers of finished uploads are recorded again, beginning resets them
+        const auto& image = pending_texture.texture->image;
+        if (free_command_buffers.empty()) {
+            free_command_buffers.push_back(command_pool.allocate_command_buffers({
+                .level                = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                .command_buffer_count = 1
+            })[0]);
+        }
+        auto command_buffer = std::move(free_command_buffers.back());
+        free_command_buffers.pop_back();
+
+        command_buffer
+            .begin({{
+                .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+            }})
+            .pipeline_barrier(
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, {}, {},
+                {
+                    {
+                        .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                        .srcAccessMask       = 0,
+                        .dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+                        .oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED,
+                        .newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .image               = image,
+                        .subresourceRange    = subresource_range
+                    }
+                }
+            )
+            .copy_buffer_to_image(
+                source,
+                image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                regions
+            )
+            .pipeline_barrier(
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                0, {}, {},
+                {
+                    {
+                        .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                        .srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+                        .dstAccessMask       = VK_ACCESS_SHADER_READ_BIT,
+                        .oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        .newLayout           = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                        .image               = image,
+                        .subresourceRange    = subresource_range
+                    }
+                }
+            )
+            .end();
+
+        // Submit without waiting, the upload timeline is polled by later updates
+        ++upload_value;
+        queue.submit({
+            {{
+                .command_buffers   = {
+                    command_buffer
+                },
+                .signal_semaphores = { upload_timeline },
+                .signal_values     = { upload_value }
+            }}
+        });
+
+        uploads.push_back({
+            .texture        = pending_texture.texture,
+            .first_level    = first_level,
+            .staging_buffer = std::move(staging_buffer),
+            .staging_end    = staging_head,
+            .command_buffer = std::move(command_buffer),
+            .timeline_value = upload_value
+        });
+
+        pending_texture.next_level = first_level;
+        return true;
+    }
+
+    std::optional<uint64_t> TextureStreamer::allocate_staging(VkDeviceSize size) {
+        // Ranges never wrap around the end of the buffer, the rest of the lap is skipped instead
+        const auto ring_size = staging_ring.size();
+        auto offset = staging_head;
+        if (offset % ring_size + size > ring_size) {
+            offset += ring_size - offset % ring_size;
+        }
+        if (offset + size - staging_tail > ring_size) return std::nullopt;
+
+        staging_head = offset + size;
+        return offset;
+    }
+
+    vulkan::ImageView TextureStreamer::create_view(const StreamingTexture& texture) const {
+        return device.create_image_view({
+            .image      = texture.image,
+            .view_type  = VK_IMAGE_VIEW_TYPE_2D,
+            .format     = texture.format,
+            .components = {
+                .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .a = VK_COMPONENT_SWIZZLE_IDENTITY
+            },
+            .subresource_range = {
+                .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel   = texture.resident_level,
+                .levelCount     = texture.mip_levels - texture.resident_level,
+                .baseArrayLayer = 0,
+                .layerCount     = 1
+            }
+        });
+    }
+
+}
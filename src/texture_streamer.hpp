@@ -0,0 +1,112 @@
+#pragma once
+
+#include "texture.hpp"
+#include "texture_file.hpp"
+#include "vulkan/command_buffer.hpp"
+#include "vulkan/command_pool.hpp"
+#include "vulkan/deletion_queue.hpp"
+#include "vulkan/device.hpp"
+#include "vulkan/physical_device.hpp"
+#include "vulkan/queue.hpp"
+#include "vulkan/staging_buffer.hpp"
+#include "vulkan/timeline_semaphore.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace stirling {
+
+    struct StreamingTexture {
+        vulkan::Image        image;
+        vulkan::DeviceMemory memory;
+        vulkan::ImageView    view;
+        VkSampler            sampler;
+        VkFormat             format;
+        VkExtent2D           extent;
+        uint32_t             mip_levels;
+        uint32_t             resident_level;
+
+        // The view covers every resident mip level. Replaced views go through the deletion queue,
+        // since frames in flight may still sample them.
+        inline bool is_resident() const { return view; }
+        inline VkImageView get_view() const { return view; }
+    };
+
+    constexpr VkDeviceSize default_staging_size = 16 * 1024 * 1024;
+
+    // Uploads compressed textures a few mip levels at a time, coarsest level first, so a
+    // low resolution version is visible almost immediately and detail ramps up over frames.
+    // Levels are staged through a persistent ring buffer and recorded into pooled command
+    // buffers, so the command pool must allow resetting individual command buffers.
+    struct TextureStreamer {
+        TextureStreamer(
+            const vulkan::PhysicalDevice& physical_device,
+            const vulkan::Device&         device,
+            const vulkan::CommandPool&    command_pool,
+            const vulkan::Queue&          queue,
+            TextureLoader&                texture_loader,
+            vulkan::DeletionQueue&        deletion_queue,
+            VkDeviceSize                  staging_size = default_staging_size);
+
+        // Picks the first file whose format the device can sample
+        std::shared_ptr<StreamingTexture> load(
+            const std::vector<const char*>&  file_names,
+            const vulkan::SamplerCreateInfo& sampler);
+
+        // Retires finished uploads and submits new ones, up to budget bytes. The first batch always
+        // goes through, so a budget of 0 submits one batch per update.
+        void update(VkDeviceSize budget);
+
+        bool is_idle() const;
+        bool supports_format(VkFormat format);
+
+    private:
+        struct PendingTexture {
+            std::shared_ptr<StreamingTexture> texture;
+            TextureFile                       file;
+            uint32_t                          next_level;
+        };
+
+        struct Upload {
+            std::shared_ptr<StreamingTexture>    texture;
+            uint32_t                             first_level;
+            std::optional<vulkan::StagingBuffer> staging_buffer; // Only for levels larger than the ring
+            uint64_t                             staging_end;    // Ring offset released on completion
+            vulkan::CommandBuffer                command_buffer;
+            uint64_t                             timeline_value;
+        };
+
+        const vulkan::PhysicalDevice&      physical_device;
+        const vulkan::Device&              device;
+        const vulkan::CommandPool&         command_pool;
+        const vulkan::Queue&               queue;
+        TextureLoader&                     texture_loader;
+        vulkan::DeletionQueue&             deletion_queue;
+        std::deque<PendingTexture>         pending_textures;
+        std::vector<Upload>                uploads;
+        std::unordered_map<VkFormat, bool> format_support;
+        vulkan::TimelineSemaphore          upload_timeline;
+        uint64_t                           upload_value;
+
+        // Ring offsets only grow, the position in the buffer is the offset modulo its size
+        vulkan::StagingBuffer              staging_ring;
+        vulkan::DeviceMemoryMapping        staging_mapping;
+        uint64_t                           staging_head;
+        uint64_t                           staging_tail;
+
+        // Reused by every upload
+        std::vector<vulkan::CommandBuffer> free_command_buffers;
+        std::vector<VkBufferImageCopy>     regions;
+
+        // Returns false when the ring has no room for the levels until earlier uploads finish
+        bool submit_upload(PendingTexture& pending_texture, uint32_t first_level, VkDeviceSize size);
+        std::optional<uint64_t> allocate_staging(VkDeviceSize size);
+        vulkan::ImageView create_view(const StreamingTexture& texture) const;
+    };
+
+}
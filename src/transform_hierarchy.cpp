@@ -0,0 +1,262 @@
+#include "transform_hierarchy.hpp"
+
+#include "simd_math.hpp"
+
+#include <algorithm>
+
+namespace stirling {
+
+    namespace {
+
+        // Index of freed nodes and parent index of roots
+        constexpr uint32_t no_index = std::numeric_limits<uint32_t>::max();
+
+        // Nodes per task, enough work to amortize waking a worker
+        constexpr uint32_t update_grain_size = 2048;
+
+        // Above one changed node in this many, scanning every level beats sorting and walking changes
+        constexpr uint32_t scan_ratio = 8;
+
+    }
+
+    TransformHandle TransformHierarchy::create(TransformHandle parent, const glm::mat4& local) {
+        TransformHandle handle;
+        if (!free_handles.empty()) {
+            handle = free_handles.back();
+            free_handles.pop_back();
+        } else {
+            handle = static_cast<TransformHandle>(nodes.size());
+            nodes.emplace_back();
+        }
+
+        // Appended unsorted, the next update sorts it into its level
+        nodes[handle] = {
+            .parent = parent,
+            .depth  = parent == no_transform ? 0 : nodes[parent].depth + 1,
+            .index  = static_cast<uint32_t>(handles.size()),
+            .alive  = true
+        };
+        locals.push_back(local);
+        worlds.push_back(local);
+        parents.push_back(no_index);
+        dirty.push_back(1);
+        updated.push_back(0);
+        handles.push_back(handle);
+
+        layout_dirty = true;
+        return handle;
+    }
+
+    void TransformHierarchy::destroy(TransformHandle node) {
+        // Handles are only freed by rebuild, so descendants never see their parent handle reused
+        nodes[node].alive = false;
+        layout_dirty = true;
+    }
+
+    void TransformHierarchy::set_local(TransformHandle node, const glm::mat4& local) {
+        const auto index = nodes[node].index;
+        locals[index] = local;
+
+        // Indices change with the layout, so the rebuild collects dirty nodes itself
+        if (!dirty[index] && !layout_dirty) {
+            dirty_nodes.push_back(index);
+        }
+        dirty[index] = 1;
+    }
+
+    void TransformHierarchy::update(WorkerPool* worker_pool) {
+        if (layout_dirty) {
+            rebuild();
+            layout_dirty = false;
+        }
+
+        // Flags of a walking update are cleared through its list instead of a pass over all nodes
+        if (updated_scan) {
+            std::fill(updated.begin(), updated.end(), 0);
+        } else {
+            for (const auto index : updated_nodes) {
+                updated[index] = 0;
+            }
+        }
+        updated_nodes.clear();
+        updated_scan = false;
+        if (dirty_nodes.empty()) return;
+
+        if (dirty_nodes.size() > handles.size() / scan_ratio) {
+            // Levels run in order, nodes of a level only read matrices and flags of shallower levels
+            for (size_t level = 0; level + 1 < levels.size(); ++level) {
+                const auto begin = levels[level];
+                const auto count = levels[level + 1] - begin;
+                if (worker_pool) {
+                    worker_pool->parallel_for(count, update_grain_size, [this, begin](uint32_t first, uint32_t last) {
+                        update_range(begin + first, begin + last);
+                    });
+                } else {
+                    update_range(begin, begin + count);
+                }
+            }
+            updated_scan = true;
+            dirty_nodes.clear();
+            return;
+        }
+
+        // Indices increase with depth, so sorted dirty nodes are consumed level by level
+        std::sort(dirty_nodes.begin(), dirty_nodes.end());
+        auto next_dirty = dirty_nodes.begin();
+
+        uint32_t parents_begin = 0;
+        for (size_t level = 0; level + 1 < levels.size(); ++level) {
+            const auto begin = static_cast<uint32_t>(updated_nodes.size());
+
+            // Every child of a node updated on the previous level
+            for (auto i = parents_begin; i < begin; ++i) {
+                const auto parent = updated_nodes[i];
+                const auto first_child = first_children[parent];
+                for (auto child = first_child; child < first_child + child_counts[parent]; ++child) {
+                    updated_nodes.push_back(child);
+                }
+            }
+
+            // Changed nodes of this level that were not reached through their parent
+            for (; next_dirty != dirty_nodes.end() && *next_dirty < levels[level + 1]; ++next_dirty) {
+                const auto parent = parents[*next_dirty];
+                if (parent == no_index || !updated[parent]) {
+                    updated_nodes.push_back(*next_dirty);
+                }
+            }
+
+            const auto end = static_cast<uint32_t>(updated_nodes.size());
+            if (begin == end && next_dirty == dirty_nodes.end()) break;
+
+            if (worker_pool) {
+                worker_pool->parallel_for(end - begin, update_grain_size, [this, begin](uint32_t first, uint32_t last) {
+                    update_nodes(begin + first, begin + last);
+                });
+            } else {
+                update_nodes(begin, end);
+            }
+            parents_begin = begin;
+        }
+        dirty_nodes.clear();
+    }
+
+    void TransformHierarchy::update_range(uint32_t begin, uint32_t end) {
+        for (auto i = begin; i < end; ++i) {
+            const auto parent = parents[i];
+            const bool changed = dirty[i] || (parent != no_index && updated[parent]);
+            updated[i] = changed;
+            if (changed) {
+                worlds[i] = parent != no_index ? multiply_matrix(worlds[parent], locals[i]) : locals[i];
+                dirty[i] = 0;
+            }
+        }
+    }
+
+    void TransformHierarchy::update_nodes(uint32_t begin, uint32_t end) {
+        for (auto i = begin; i < end; ++i) {
+            const auto index = updated_nodes[i];
+            const auto parent = parents[index];
+            worlds[index] = parent != no_index ? multiply_matrix(worlds[parent], locals[index]) : locals[index];
+            dirty[index] = 0;
+            updated[index] = 1;
+        }
+    }
+
+    void TransformHierarchy::rebuild() {
+        // Children of every live handle, counting sorted by parent
+        std::vector<uint32_t> child_offsets(nodes.size() + 1, 0);
+        for (const auto& node : nodes) {
+            if (node.index != no_index && node.parent != no_transform) {
+                ++child_offsets[node.parent + 1];
+            }
+        }
+        for (size_t handle = 1; handle < child_offsets.size(); ++handle) {
+            child_offsets[handle] += child_offsets[handle - 1];
+        }
+
+        std::vector<TransformHandle> order;
+        std::vector<TransformHandle> children(child_offsets.back());
+        auto next_child = child_offsets;
+        for (TransformHandle handle = 0; handle < nodes.size(); ++handle) {
+            const auto& node = nodes[handle];
+            if (node.index == no_index) continue;
+            if (node.parent == no_transform) {
+                order.push_back(handle);
+            } else {
+                children[next_child[node.parent]++] = handle;
+            }
+        }
+
+        // Breadth first from the roots, so depths never decrease and siblings are adjacent
+        order.reserve(order.size() + children.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            const auto handle = order[i];
+            order.insert(order.end(), children.begin() + child_offsets[handle], children.begin() + child_offsets[handle + 1]);
+        }
+
+        // Parents precede their children, so destruction propagates down and parent indices are final
+        std::vector<glm::mat4>       sorted_locals;
+        std::vector<glm::mat4>       sorted_worlds;
+        std::vector<uint32_t>        sorted_parents;
+        std::vector<uint32_t>        sorted_first_children;
+        std::vector<uint32_t>        sorted_child_counts;
+        std::vector<uint8_t>         sorted_dirty;
+        std::vector<TransformHandle> sorted_handles;
+        sorted_locals.reserve(order.size());
+        sorted_worlds.reserve(order.size());
+        sorted_parents.reserve(order.size());
+        sorted_first_children.reserve(order.size());
+        sorted_child_counts.reserve(order.size());
+        sorted_dirty.reserve(order.size());
+        sorted_handles.reserve(order.size());
+        levels.clear();
+        dirty_nodes.clear();
+        updated_nodes.clear();
+
+        for (const auto handle : order) {
+            auto& node = nodes[handle];
+            if (node.alive && node.parent != no_transform) {
+                node.alive = nodes[node.parent].alive;
+            }
+            if (!node.alive) {
+                node.index = no_index;
+                free_handles.push_back(handle);
+                continue;
+            }
+
+            const auto index = static_cast<uint32_t>(sorted_handles.size());
+            while (levels.size() <= node.depth) {
+                levels.push_back(index);
+            }
+
+            // Siblings are adjacent, so each node only records its first child and their count
+            const auto parent = node.parent != no_transform ? nodes[node.parent].index : no_index;
+            if (parent != no_index && sorted_child_counts[parent]++ == 0) {
+                sorted_first_children[parent] = index;
+            }
+            if (dirty[node.index]) {
+                dirty_nodes.push_back(index);
+            }
+
+            sorted_locals.push_back(locals[node.index]);
+            sorted_worlds.push_back(worlds[node.index]);
+            sorted_parents.push_back(parent);
+            sorted_first_children.push_back(0);
+            sorted_child_counts.push_back(0);
+            sorted_dirty.push_back(dirty[node.index]);
+            sorted_handles.push_back(handle);
+            node.index = index;
+        }
+        levels.push_back(static_cast<uint32_t>(sorted_handles.size()));
+
+        locals.swap(sorted_locals);
+        worlds.swap(sorted_worlds);
+        parents.swap(sorted_parents);
+        first_children.swap(sorted_first_children);
+        child_counts.swap(sorted_child_counts);
+        dirty.swap(sorted_dirty);
+        handles.swap(sorted_handles);
+        updated.assign(handles.size(), 0);
+    }
+
+}
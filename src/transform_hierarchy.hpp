@@ -0,0 +1,80 @@
+#pragma once
+
+#include "worker_pool.hpp"
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace stirling {
+
+    using TransformHandle = uint32_t;
+
+    constexpr TransformHandle no_transform = std::numeric_limits<TransformHandle>::max();
+
+    // Local and world matrices of a node hierarchy, stored as separate arrays in breadth first order
+    // so parents are always updated before their children and siblings are adjacent. An update only
+    // visits the subtrees below nodes whose local matrix changed, or scans every node when many did,
+    // the nodes of one depth are updated in parallel. Handles stay valid until destroyed, the sorted
+    // order is rebuilt on the first update after nodes were created or destroyed.
+    struct TransformHierarchy {
+        TransformHandle create(TransformHandle parent = no_transform, const glm::mat4& local = glm::mat4(1.0f));
+
+        // Destroys the node with all of its descendants
+        void destroy(TransformHandle node);
+
+        void set_local(TransformHandle node, const glm::mat4& local);
+
+        inline const glm::mat4& get_local(TransformHandle node) const { return locals[nodes[node].index]; }
+        inline TransformHandle get_parent(TransformHandle node) const { return nodes[node].parent; }
+
+        // Valid after the update following the last change of the node or its ancestors
+        inline const glm::mat4& get_world(TransformHandle node) const { return worlds[nodes[node].index]; }
+
+        // Whether the last update recomputed the world matrix of the node
+        inline bool was_updated(TransformHandle node) const { return updated[nodes[node].index] != 0; }
+
+        // Propagates changed local matrices to world matrices, in parallel when given a pool
+        void update(WorkerPool* worker_pool = nullptr);
+
+        inline size_t size() const { return handles.size(); }
+
+    private:
+        struct Node {
+            TransformHandle parent;
+            uint32_t        depth;
+            uint32_t        index; // Into the sorted arrays
+            bool            alive;
+        };
+
+        // Per handle, dead handles are reused
+        std::vector<Node>            nodes;
+        std::vector<TransformHandle> free_handles;
+
+        // Breadth first, levels[d] is the first index of depth d
+        std::vector<glm::mat4>       locals;
+        std::vector<glm::mat4>       worlds;
+        std::vector<uint32_t>        parents;
+        std::vector<uint32_t>        first_children; // Children are adjacent, in the next level
+        std::vector<uint32_t>        child_counts;
+        std::vector<uint8_t>         dirty;
+        std::vector<uint8_t>         updated;
+        std::vector<TransformHandle> handles;
+        std::vector<uint32_t>        levels;
+
+        // Indices changed since and recomputed by the last update
+        std::vector<uint32_t>        dirty_nodes;
+        std::vector<uint32_t>        updated_nodes;
+
+        bool                         layout_dirty = false;
+        bool                         updated_scan = false; // Last update wrote the flags of every node
+
+        void rebuild();
+        void update_range(uint32_t begin, uint32_t end);
+        void update_nodes(uint32_t begin, uint32_t end);
+    };
+
+}
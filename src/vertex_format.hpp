@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace stirling {
+
+    // Encodings of packed vertex components, mapped to Vulkan formats by VertexLayout
+    struct Float {};
+    struct Snorm {};
+    struct Unorm {};
+    struct Octahedral {};
+
+    template<typename Component, size_t Count, typename Encoding>
+    struct PackedVector {
+        Component value[Count];
+
+        inline Component& operator[](size_t i) { return value[i]; }
+        inline const Component& operator[](size_t i) const { return value[i]; }
+    };
+
+    using half2      = PackedVector<uint16_t, 2, Float>;
+    using half4      = PackedVector<uint16_t, 4, Float>;
+    using snorm8x4   = PackedVector<int8_t,   4, Snorm>;
+    using snorm16x2  = PackedVector<int16_t,  2, Snorm>;
+    using snorm16x4  = PackedVector<int16_t,  4, Snorm>;
+    using unorm8x4   = PackedVector<uint8_t,  4, Unorm>;
+    using unorm16x2  = PackedVector<uint16_t, 2, Unorm>;
+    using octahedral = PackedVector<int16_t,  2, Octahedral>;
+
+    inline int16_t pack_snorm16(float value) {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767));
+    }
+
+    inline int8_t pack_snorm8(float value) {
+        return static_cast<int8_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 127));
+    }
+
+    inline uint8_t pack_unorm8(float value) {
+        return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255));
+    }
+
+    // Truncating float to half conversion, denormals flush to zero
+    inline uint16_t pack_half(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+        const auto exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+        if (exponent <= 0) return sign;
+        if (exponent >= 31) return sign | 0x7c00;
+        return sign | static_cast<uint16_t>(exponent << 10) | static_cast<uint16_t>((bits & 0x7fffff) >> 13);
+    }
+
+    // Projects a unit vector onto the octahedron and unfolds the lower half, decoded in the shader with
+    // n = vec3(e, 1 - |e.x| - |e.y|); if (n.z < 0) n.xy = (1 - abs(n.yx)) * sign(n.xy); normalize(n)
+    inline octahedral pack_octahedral(const float normal[3]) {
+        const auto length = std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]);
+        if (length == 0.0f) return {{ 0, 0 }};
+
+        auto x = normal[0] / length;
+        auto y = normal[1] / length;
+        if (normal[2] < 0.0f) {
+            const auto folded_x = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            const auto folded_y = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+            x = folded_x;
+            y = folded_y;
+        }
+        return {{ pack_snorm16(x), pack_snorm16(y) }};
+    }
+
+}
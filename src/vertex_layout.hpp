@@ -0,0 +1,104 @@
+#pragma once
+
+#include "vertex_format.hpp"
+#include "vulkan/pipeline.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <glm/glm.hpp>
+
+#include <type_traits>
+#include <vector>
+
+namespace stirling {
+
+    // Vulkan format of a vertex attribute type, specialized for every supported component type
+    template<typename T>
+    struct VertexAttributeFormat {
+        static_assert(sizeof(T) == 0, "Unsupported vertex attribute type.");
+    };
+
+    template<VkFormat Format>
+    struct VertexAttributeFormatValue {
+        static constexpr VkFormat format = Format;
+    };
+
+    template<> struct VertexAttributeFormat<float>      : VertexAttributeFormatValue<VK_FORMAT_R32_SFLOAT> {};
+    template<> struct VertexAttributeFormat<glm::vec2>  : VertexAttributeFormatValue<VK_FORMAT_R32G32_SFLOAT> {};
+    template<> struct VertexAttributeFormat<glm::vec3>  : VertexAttributeFormatValue<VK_FORMAT_R32G32B32_SFLOAT> {};
+    template<> struct VertexAttributeFormat<glm::vec4>  : VertexAttributeFormatValue<VK_FORMAT_R32G32B32A32_SFLOAT> {};
+    template<> struct VertexAttributeFormat<half2>      : VertexAttributeFormatValue<VK_FORMAT_R16G16_SFLOAT> {};
+    template<> struct VertexAttributeFormat<half4>      : VertexAttributeFormatValue<VK_FORMAT_R16G16B16A16_SFLOAT> {};
+    template<> struct VertexAttributeFormat<snorm8x4>   : VertexAttributeFormatValue<VK_FORMAT_R8G8B8A8_SNORM> {};
+    template<> struct VertexAttributeFormat<snorm16x2>  : VertexAttributeFormatValue<VK_FORMAT_R16G16_SNORM> {};
+    template<> struct VertexAttributeFormat<snorm16x4>  : VertexAttributeFormatValue<VK_FORMAT_R16G16B16A16_SNORM> {};
+    template<> struct VertexAttributeFormat<unorm8x4>   : VertexAttributeFormatValue<VK_FORMAT_R8G8B8A8_UNORM> {};
+    template<> struct VertexAttributeFormat<unorm16x2>  : VertexAttributeFormatValue<VK_FORMAT_R16G16_UNORM> {};
+    template<> struct VertexAttributeFormat<octahedral> : VertexAttributeFormatValue<VK_FORMAT_R16G16_SNORM> {};
+
+    template<typename T>
+    struct MemberPointerTraits;
+
+    template<typename Class, typename Member>
+    struct MemberPointerTraits<Member Class::*> {
+        using class_type  = Class;
+        using member_type = Member;
+    };
+
+    // Vertex input state derived from a vertex struct, attributes get consecutive locations in the
+    // order the members are listed, e.g. VertexLayout<Vertex, &Vertex::position, &Vertex::color>
+    template<typename Vertex, auto... Members>
+    struct VertexLayout {
+        static_assert(std::is_standard_layout_v<Vertex>, "Vertex must be a standard layout type.");
+        static_assert(
+            (std::is_same_v<typename MemberPointerTraits<decltype(Members)>::class_type, Vertex> && ...),
+            "Vertex layout members must belong to the vertex type.");
+
+        static constexpr uint32_t stride          = sizeof(Vertex);
+        static constexpr uint32_t attribute_count = sizeof...(Members);
+
+        static VkVertexInputBindingDescription get_binding_description(
+            uint32_t          binding,
+            VkVertexInputRate input_rate = VK_VERTEX_INPUT_RATE_VERTEX) {
+
+            return {
+                .binding   = binding,
+                .stride    = stride,
+                .inputRate = input_rate
+            };
+        }
+
+        static std::vector<VkVertexInputAttributeDescription> get_attribute_descriptions(
+            uint32_t binding,
+            uint32_t first_location = 0) {
+
+            auto location = first_location;
+            return {
+                {
+                    .location = location++,
+                    .binding  = binding,
+                    .format   = VertexAttributeFormat<typename MemberPointerTraits<decltype(Members)>::member_type>::format,
+                    .offset   = get_offset(Members)
+                }...
+            };
+        }
+
+        static vulkan::PipelineVertexInputStateCreateInfo get_input_state(uint32_t binding = 0) {
+            return {
+                .vertex_binding_descriptions   = { get_binding_description(binding) },
+                .vertex_attribute_descriptions = get_attribute_descriptions(binding)
+            };
+        }
+
+    private:
+        template<typename Member>
+        static uint32_t get_offset(Member Vertex::* member) {
+            // Offset of the member within an uninitialized vertex, offsetof is not usable with member pointers
+            alignas(Vertex) static const unsigned char storage[sizeof(Vertex)] = {};
+            const auto vertex = reinterpret_cast<const Vertex*>(storage);
+            return static_cast<uint32_t>(
+                reinterpret_cast<const unsigned char*>(&(vertex->*member)) - storage);
+        }
+    };
+
+}
@@ -0,0 +1,176 @@
+#include "bindless_descriptors.hpp"
+#include "vulkan.hpp"
+#include "vulkan_create.hpp"
+
+namespace stirling { namespace vulkan {
+
+    namespace {
+
+        constexpr VkDescriptorBindingFlagsEXT bindless_binding_flags =
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+        Deleter<VkDescriptorSetLayout> create_bindless_layout(
+            const BindlessDescriptorsCreateInfo& create_info,
+            VkDevice                             device) {
+
+            const VkDescriptorSetLayoutBinding bindings[] = {
+                {
+                    .binding         = BindlessDescriptors::texture_binding,
+                    .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                    .descriptorCount = create_info.max_textures,
+                    .stageFlags      = VK_SHADER_STAGE_ALL
+                },
+                {
+                    .binding         = BindlessDescriptors::buffer_binding,
+                    .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                    .descriptorCount = create_info.max_buffers,
+                    .stageFlags      = VK_SHADER_STAGE_ALL
+                }
+            };
+            const VkDescriptorBindingFlagsEXT binding_flags[] = {
+                bindless_binding_flags,
+                bindless_binding_flags
+            };
+
+            const VkDescriptorSetLayoutBindingFlagsCreateInfoEXT vk_binding_flags {
+                .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT,
+                .bindingCount  = 2,
+                .pBindingFlags = binding_flags
+            };
+
+            const VkDescriptorSetLayoutCreateInfo vk_create_info {
+                .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+                .pNext        = &vk_binding_flags,
+                .flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT,
+                .bindingCount = 2,
+                .pBindings    = bindings
+            };
+
+            return create<VkDescriptorSetLayout>(
+                vkCreateDescriptorSetLayout,
+                vkDestroyDescriptorSetLayout,
+                device,
+                "Failed to create bindless descriptor set layout.",
+                &vk_create_info
+            );
+        }
+
+    }
+
+    uint32_t BindlessDescriptors::Slots::acquire(const char* exhausted_message) {
+        if (!free.empty()) {
+            const auto index = free.back();
+            free.pop_back();
+            used[index] = 1;
+            return index;
+        }
+        if (count == capacity) throw exhausted_message;
+        used.push_back(1);
+        return count++;
+    }
+
+    void BindlessDescriptors::Slots::release(uint32_t index, const char* unused_message) {
+        // A second release would hand the same slot to two later adds
+        if (index >= count || !used[index]) throw unused_message;
+        used[index] = 0;
+        free.push_back(index);
+    }
+
+    BindlessDescriptors::BindlessDescriptors(
+        const BindlessDescriptorsCreateInfo& create_info,
+        VkDevice                             device) :
+
+        layout   (create_bindless_layout(create_info, device)),
+        pool     ({
+            .flags      = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT,
+            .max_sets   = 1,
+            .pool_sizes = {
+                {
+                    .type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                    .descriptorCount = create_info.max_textures
+                },
+                {
+                    .type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                    .descriptorCount = create_info.max_buffers
+                }
+            }
+        }, device),
+        device   (device),
+        textures {create_info.max_textures, 0, {}, {}},
+        buffers  {create_info.max_buffers, 0, {}, {}} {
+
+        if (!pool.try_allocate_descriptor_sets({ .set_layouts = { layout } }, &descriptor_set)) {
+            throw "Failed to allocate bindless descriptor set.";
+        }
+    }
+
+    uint32_t BindlessDescriptors::add_texture(VkImageView image_view, VkSampler sampler, VkImageLayout image_layout) {
+        const auto index = textures.acquire("Bindless texture table is full.");
+        pending_textures.push_back(index);
+        texture_infos.push_back({
+            .sampler     = sampler,
+            .imageView   = image_view,
+            .imageLayout = image_layout
+        });
+        return index;
+    }
+
+    uint32_t BindlessDescriptors::add_buffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+        const auto index = buffers.acquire("Bindless buffer table is full.");
+        pending_buffers.push_back(index);
+        buffer_infos.push_back({
+            .buffer = buffer,
+            .offset = offset,
+            .range  = range
+        });
+        return index;
+    }
+
+    void BindlessDescriptors::remove_texture(uint32_t index) {
+        textures.release(index, "Bindless texture index is not in use.");
+    }
+
+    void BindlessDescriptors::remove_buffer(uint32_t index) {
+        buffers.release(index, "Bindless buffer index is not in use.");
+    }
+
+    void BindlessDescriptors::flush() {
+        std::vector<VkWriteDescriptorSet> writes;
+        writes.reserve(pending_textures.size() + pending_buffers.size());
+
+        for (size_t i = 0; i < pending_textures.size(); ++i) {
+            writes.push_back({
+                .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet          = descriptor_set,
+                .dstBinding      = texture_binding,
+                .dstArrayElement = pending_textures[i],
+                .descriptorCount = 1,
+                .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                .pImageInfo      = &texture_infos[i]
+            });
+        }
+        for (size_t i = 0; i < pending_buffers.size(); ++i) {
+            writes.push_back({
+                .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet          = descriptor_set,
+                .dstBinding      = buffer_binding,
+                .dstArrayElement = pending_buffers[i],
+                .descriptorCount = 1,
+                .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                .pBufferInfo     = &buffer_infos[i]
+            });
+        }
+
+        if (!writes.empty()) {
+            vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        }
+
+        pending_textures.clear();
+        texture_infos.clear();
+        pending_buffers.clear();
+        buffer_infos.clear();
+    }
+
+}}
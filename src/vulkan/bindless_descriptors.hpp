@@ -0,0 +1,66 @@
+#pragma once
+
+#include "deleter.hpp"
+#include "descriptor_pool.hpp"
+#include "vulkan_structs.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+namespace stirling { namespace vulkan {
+
+    struct BindlessDescriptorsCreateInfo {
+        uint32_t max_textures;
+        uint32_t max_buffers;
+    };
+
+    // One update-after-bind set holding every texture and storage buffer in large partially bound
+    // arrays. Draws address resources by the returned indices, passed through push constants or
+    // instance data, so the set is bound once per command buffer instead of once per draw.
+    struct BindlessDescriptors {
+        static constexpr uint32_t texture_binding = 0;
+        static constexpr uint32_t buffer_binding  = 1;
+
+        BindlessDescriptors(
+            const BindlessDescriptorsCreateInfo& create_info,
+            VkDevice                             device);
+
+        inline operator const VkDescriptorSet() const { return descriptor_set; }
+        inline VkDescriptorSetLayout get_layout() const { return layout; }
+
+        uint32_t add_texture(VkImageView image_view, VkSampler sampler, VkImageLayout image_layout);
+        uint32_t add_buffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+
+        // Indices are reused by later adds, only remove once no pending frame reads the slot. Removing
+        // an index that is not in use throws.
+        void remove_texture(uint32_t index);
+        void remove_buffer(uint32_t index);
+
+        // Issues every queued write in a single vkUpdateDescriptorSets call
+        void flush();
+
+    private:
+        struct Slots {
+            uint32_t              capacity;
+            uint32_t              count;
+            std::vector<uint32_t> free;
+            std::vector<uint8_t>  used; // Per slot below count, catches invalid and double releases
+
+            uint32_t acquire(const char* exhausted_message);
+            void release(uint32_t index, const char* unused_message);
+        };
+
+        Deleter<VkDescriptorSetLayout>      layout;
+        DescriptorPool                      pool;
+        VkDescriptorSet                     descriptor_set;
+        VkDevice                            device;
+        Slots                               textures;
+        Slots                               buffers;
+        std::vector<uint32_t>               pending_textures;
+        std::vector<VkDescriptorImageInfo>  texture_infos;
+        std::vector<uint32_t>               pending_buffers;
+        std::vector<VkDescriptorBufferInfo> buffer_infos;
+    };
+
+}}
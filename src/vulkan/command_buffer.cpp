@@ -1,14 +1,37 @@
 #include "command_buffer.hpp"
 #include "vulkan.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace stirling { namespace vulkan {
 
+    namespace {
+
+        // Index of the shadowed state of a bind point, or none for bind points that are not shadowed
+        constexpr uint32_t unshadowed_bind_point = ~0u;
+
+        inline uint32_t get_bind_point_index(VkPipelineBindPoint pipeline_bind_point) {
+            switch (pipeline_bind_point) {
+                case VK_PIPELINE_BIND_POINT_GRAPHICS: return 0;
+                case VK_PIPELINE_BIND_POINT_COMPUTE:  return 1;
+                default:                              return unshadowed_bind_point;
+            }
+        }
+
+    }
+
     CommandBuffer::CommandBuffer(Deleter<VkCommandBuffer>&& command_buffer) :
-        command_buffer (command_buffer) {
+        command_buffer (command_buffer),
+        bound          {},
+        skipped_binds  (0) {
     } 
 
     const CommandBuffer& CommandBuffer::begin(const CommandBufferBeginInfo& begin_info) const {
         vulkan::begin_command_buffer(begin_info, command_buffer);
+
+        // Beginning resets every binding of the command buffer
+        bound = {};
         return *this;
     }
 
@@ -31,14 +54,90 @@ namespace stirling { namespace vulkan {
     }
 
     const CommandBuffer& CommandBuffer::copy_buffer(
-        VkBuffer                         src_buffer,
-        VkBuffer                         dst_buffer,
-        const std::vector<VkBufferCopy>& regions) const {
+        VkBuffer           src_buffer,
+        VkBuffer           dst_buffer,
+        Span<VkBufferCopy> regions) const {
 
         vulkan::cmd_copy_buffer(command_buffer, src_buffer, dst_buffer, regions);
         return *this;
     }
 
+    const CommandBuffer& CommandBuffer::copy_buffer_to_image(
+        VkBuffer                src_buffer,
+        VkImage                 dst_image,
+        VkImageLayout           dst_image_layout,
+        Span<VkBufferImageCopy> regions) const {
+
+        vulkan::cmd_copy_buffer_to_image(command_buffer, src_buffer, dst_image, dst_image_layout, regions);
+        return *this;
+    }
+
+    const CommandBuffer& CommandBuffer::blit_image(
+        VkImage           src_image,
+        VkImageLayout     src_image_layout,
+        VkImage           dst_image,
+        VkImageLayout     dst_image_layout,
+        Span<VkImageBlit> regions,
+        VkFilter          filter) const {
+
+        vulkan::cmd_blit_image(
+            command_buffer,
+            src_image,
+            src_image_layout,
+            dst_image,
+            dst_image_layout,
+            regions,
+            filter
+        );
+        return *this;
+    }
+
+    const CommandBuffer& CommandBuffer::pipeline_barrier(
+        VkPipelineStageFlags        src_stage_mask,
+        VkPipelineStageFlags        dst_stage_mask,
+        VkDependencyFlags           dependency_flags,
+        Span<VkMemoryBarrier>       memory_barriers,
+        Span<VkBufferMemoryBarrier> buffer_memory_barriers,
+        Span<VkImageMemoryBarrier>  image_memory_barriers) const {
+
+        vulkan::cmd_pipeline_barrier(
+            command_buffer,
+            src_stage_mask,
+            dst_stage_mask,
+            dependency_flags,
+            memory_barriers,
+            buffer_memory_barriers,
+            image_memory_barriers
+        );
+        return *this;
+    }
+
+    const CommandBuffer& CommandBuffer::reset_query_pool(
+        VkQueryPool query_pool,
+        uint32_t    first_query,
+        uint32_t    query_count) const {
+
+        vkCmdResetQueryPool(command_buffer, query_pool, first_query, query_count);
+        return *this;
+    }
+
+    const CommandBuffer& CommandBuffer::begin_query(
+        VkQueryPool         query_pool,
+        uint32_t            query,
+        VkQueryControlFlags flags) const {
+
+        vkCmdBeginQuery(command_buffer, query_pool, query, flags);
+        return *this;
+    }
+
+    const CommandBuffer& CommandBuffer::end_query(
+        VkQueryPool query_pool,
+        uint32_t    query) const {
+
+        vkCmdEndQuery(command_buffer, query_pool, query);
+        return *this;
+    }
+
     const CommandBuffer& CommandBuffer::draw_indexed(
         uint32_t index_count,
         uint32_t instance_count,
@@ -57,18 +156,66 @@ namespace stirling { namespace vulkan {
         return *this;
     }
 
+    const CommandBuffer& CommandBuffer::set_viewport(
+        uint32_t         first_viewport,
+        Span<VkViewport> viewports) const {
+
+        vulkan::cmd_set_viewport(command_buffer, first_viewport, viewports);
+        return *this;
+    }
+
+    const CommandBuffer& CommandBuffer::set_scissor(
+        uint32_t       first_scissor,
+        Span<VkRect2D> scissors) const {
+
+        vulkan::cmd_set_scissor(command_buffer, first_scissor, scissors);
+        return *this;
+    }
+
     const CommandBuffer& CommandBuffer::bind_pipeline(
         VkPipelineBindPoint pipeline_bind_point,
         VkPipeline          pipeline) const {
 
+        const auto bind_point = get_bind_point_index(pipeline_bind_point);
+        if (bind_point != unshadowed_bind_point) {
+            if (bound.pipelines[bind_point] == pipeline) {
+                ++skipped_binds;
+                return *this;
+            }
+            bound.pipelines[bind_point] = pipeline;
+        }
+
         vkCmdBindPipeline(command_buffer, pipeline_bind_point, pipeline);
         return *this;
     }
 
     const CommandBuffer& CommandBuffer::bind_vertex_buffers(
-        uint32_t                         first_binding,
-        const std::vector<VkBuffer>&     buffers,
-        const std::vector<VkDeviceSize>& offsets) const {
+        uint32_t           first_binding,
+        Span<VkBuffer>     buffers,
+        Span<VkDeviceSize> offsets) const {
+
+        assert(buffers.size() == offsets.size());
+        const auto binding_count = static_cast<uint32_t>(buffers.size());
+        if (first_binding + binding_count <= max_shadowed_vertex_buffers) {
+            bool redundant = true;
+            for (uint32_t i = 0; i < binding_count; ++i) {
+                const auto binding = first_binding + i;
+                redundant &= bound.vertex_buffers[binding] == buffers.begin()[i] &&
+                             bound.vertex_offsets[binding] == offsets.begin()[i];
+                bound.vertex_buffers[binding] = buffers.begin()[i];
+                bound.vertex_offsets[binding] = offsets.begin()[i];
+            }
+            if (redundant) {
+                ++skipped_binds;
+                return *this;
+            }
+        } else {
+            // Always forwarded, but the shadowed slots the bind covers still take its buffers
+            for (auto binding = first_binding; binding < std::min(first_binding + binding_count, max_shadowed_vertex_buffers); ++binding) {
+                bound.vertex_buffers[binding] = buffers.begin()[binding - first_binding];
+                bound.vertex_offsets[binding] = offsets.begin()[binding - first_binding];
+            }
+        }
 
         vulkan::cmd_bind_vertex_buffers(command_buffer, first_binding, buffers, offsets);
         return *this;
@@ -79,16 +226,47 @@ namespace stirling { namespace vulkan {
         VkDeviceSize offset,
         VkIndexType  index_type) const {
 
+        if (bound.index_buffer == buffer && bound.index_offset == offset && bound.index_type == index_type) {
+            ++skipped_binds;
+            return *this;
+        }
+        bound.index_buffer = buffer;
+        bound.index_offset = offset;
+        bound.index_type   = index_type;
+
         vulkan::cmd_bind_index_buffer(command_buffer, buffer, offset, index_type);
         return *this;
     }
 
     const CommandBuffer& CommandBuffer::bind_descriptor_sets(
-        VkPipelineBindPoint          pipeline_bind_point,
-        VkPipelineLayout             layout,
-        uint32_t                     first_set,
-        std::vector<VkDescriptorSet> descriptor_sets,
-        std::vector<uint32_t>        dynamic_offsets) const {
+        VkPipelineBindPoint   pipeline_bind_point,
+        VkPipelineLayout      layout,
+        uint32_t              first_set,
+        Span<VkDescriptorSet> descriptor_sets,
+        Span<uint32_t>        dynamic_offsets) const {
+
+        const auto bind_point = get_bind_point_index(pipeline_bind_point);
+        if (bind_point != unshadowed_bind_point) {
+            auto& bound_sets = bound.descriptor_sets[bind_point];
+
+            // Sets bound with another layout may have been disturbed, so forget all of them
+            if (bound.layouts[bind_point] != layout) {
+                bound.layouts[bind_point] = layout;
+                std::fill(std::begin(bound_sets), std::end(bound_sets), static_cast<VkDescriptorSet>(VK_NULL_HANDLE));
+            }
+
+            // Dynamic offsets are not shadowed, binds that use them are always forwarded
+            const auto set_count = static_cast<uint32_t>(descriptor_sets.size());
+            if (dynamic_offsets.size() == 0 && first_set + set_count <= max_shadowed_descriptor_sets) {
+                if (std::equal(descriptor_sets.begin(), descriptor_sets.end(), bound_sets + first_set)) {
+                    ++skipped_binds;
+                    return *this;
+                }
+                std::copy(descriptor_sets.begin(), descriptor_sets.end(), bound_sets + first_set);
+            } else {
+                std::fill(std::begin(bound_sets), std::end(bound_sets), static_cast<VkDescriptorSet>(VK_NULL_HANDLE));
+            }
+        }
 
         vulkan::cmd_bind_descriptor_sets(
             command_buffer,
@@ -100,5 +278,16 @@ namespace stirling { namespace vulkan {
         );
         return *this;
     }
+
+    const CommandBuffer& CommandBuffer::push_constants(
+        VkPipelineLayout   layout,
+        VkShaderStageFlags stage_flags,
+        uint32_t           offset,
+        uint32_t           size,
+        const void*        values) const {
+
+        vkCmdPushConstants(command_buffer, layout, stage_flags, offset, size, values);
+        return *this;
+    }
     
 }}
\ No newline at end of file
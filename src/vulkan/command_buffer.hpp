@@ -7,10 +7,17 @@
 
 #include <vulkan/vulkan.h>
 
+#include <type_traits>
 #include <vector>
 
 namespace stirling { namespace vulkan {
 
+    // Bound state shadowed by CommandBuffer, larger slot indices are always forwarded
+    constexpr uint32_t max_shadowed_descriptor_sets = 8;
+    constexpr uint32_t max_shadowed_vertex_buffers  = 16;
+
+    // Binds that match the state already bound in the command buffer are dropped before reaching the
+    // driver. The shadowed state is reset by begin.
     struct CommandBuffer {
         CommandBuffer(Deleter<VkCommandBuffer>&& command_buffer);
 
@@ -25,9 +32,45 @@ namespace stirling { namespace vulkan {
         const CommandBuffer& end_render_pass() const;
 
         const CommandBuffer& copy_buffer(
-            VkBuffer                         src_buffer,
-            VkBuffer                         dst_buffer,
-            const std::vector<VkBufferCopy>& regions) const;
+            VkBuffer           src_buffer,
+            VkBuffer           dst_buffer,
+            Span<VkBufferCopy> regions) const;
+
+        const CommandBuffer& copy_buffer_to_image(
+            VkBuffer                src_buffer,
+            VkImage                 dst_image,
+            VkImageLayout           dst_image_layout,
+            Span<VkBufferImageCopy> regions) const;
+
+        const CommandBuffer& blit_image(
+            VkImage           src_image,
+            VkImageLayout     src_image_layout,
+            VkImage           dst_image,
+            VkImageLayout     dst_image_layout,
+            Span<VkImageBlit> regions,
+            VkFilter          filter) const;
+
+        const CommandBuffer& pipeline_barrier(
+            VkPipelineStageFlags        src_stage_mask,
+            VkPipelineStageFlags        dst_stage_mask,
+            VkDependencyFlags           dependency_flags,
+            Span<VkMemoryBarrier>       memory_barriers,
+            Span<VkBufferMemoryBarrier> buffer_memory_barriers,
+            Span<VkImageMemoryBarrier>  image_memory_barriers) const;
+
+        const CommandBuffer& reset_query_pool(
+            VkQueryPool query_pool,
+            uint32_t    first_query,
+            uint32_t    query_count) const;
+
+        const CommandBuffer& begin_query(
+            VkQueryPool         query_pool,
+            uint32_t            query,
+            VkQueryControlFlags flags) const;
+
+        const CommandBuffer& end_query(
+            VkQueryPool query_pool,
+            uint32_t    query) const;
 
         const CommandBuffer& draw_indexed(
             uint32_t index_count,
@@ -36,14 +79,22 @@ namespace stirling { namespace vulkan {
             int32_t  vertex_offset,
             uint32_t first_instance) const;
 
+        const CommandBuffer& set_viewport(
+            uint32_t         first_viewport,
+            Span<VkViewport> viewports) const;
+
+        const CommandBuffer& set_scissor(
+            uint32_t       first_scissor,
+            Span<VkRect2D> scissors) const;
+
         const CommandBuffer& bind_pipeline(
             VkPipelineBindPoint pipeline_bind_point,
             VkPipeline          pipeline) const;
 
         const CommandBuffer& bind_vertex_buffers(
-            uint32_t                         first_binding,
-            const std::vector<VkBuffer>&     buffers,
-            const std::vector<VkDeviceSize>& offsets) const;
+            uint32_t           first_binding,
+            Span<VkBuffer>     buffers,
+            Span<VkDeviceSize> offsets) const;
 
         const CommandBuffer& bind_index_buffer(
             VkBuffer     buffer,
@@ -51,14 +102,50 @@ namespace stirling { namespace vulkan {
             VkIndexType  index_type) const;
 
         const CommandBuffer& bind_descriptor_sets(
-            VkPipelineBindPoint          pipeline_bind_point,
-            VkPipelineLayout             layout,
-            uint32_t                     first_set,
-            std::vector<VkDescriptorSet> descriptor_sets,
-            std::vector<uint32_t>        dynamic_offsets) const;
+            VkPipelineBindPoint   pipeline_bind_point,
+            VkPipelineLayout      layout,
+            uint32_t              first_set,
+            Span<VkDescriptorSet> descriptor_sets,
+            Span<uint32_t>        dynamic_offsets) const;
+
+        const CommandBuffer& push_constants(
+            VkPipelineLayout   layout,
+            VkShaderStageFlags stage_flags,
+            uint32_t           offset,
+            uint32_t           size,
+            const void*        values) const;
+
+        // Pushes a whole struct, its layout must match the push constant block of the shader
+        template<typename T>
+        inline const CommandBuffer& push_constants(
+            VkPipelineLayout   layout,
+            VkShaderStageFlags stage_flags,
+            const T&           values,
+            uint32_t           offset = 0) const {
+
+            static_assert(std::is_trivially_copyable<T>::value, "Push constants must be trivially copyable.");
+            static_assert(sizeof(T) % 4 == 0, "Push constant size must be a multiple of 4.");
+            return push_constants(layout, stage_flags, offset, sizeof(T), &values);
+        }
+
+        inline uint64_t get_skipped_bind_count() const { return skipped_binds; }
 
     private:
+        // Shadowed per bind point, graphics and compute
+        struct BoundState {
+            VkPipeline       pipelines[2];
+            VkPipelineLayout layouts[2];
+            VkDescriptorSet  descriptor_sets[2][max_shadowed_descriptor_sets];
+            VkBuffer         vertex_buffers[max_shadowed_vertex_buffers];
+            VkDeviceSize     vertex_offsets[max_shadowed_vertex_buffers];
+            VkBuffer         index_buffer;
+            VkDeviceSize     index_offset;
+            VkIndexType      index_type;
+        };
+
         Deleter<VkCommandBuffer> command_buffer;
+        mutable BoundState       bound;
+        mutable uint64_t         skipped_binds;
     };
 
 }}
\ No newline at end of file
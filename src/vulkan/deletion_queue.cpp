@@ -0,0 +1,30 @@
+#include "deletion_queue.hpp"
+
+namespace stirling { namespace vulkan {
+
+    DeletionQueue::DeletionQueue(const TimelineSemaphore& timeline) :
+        timeline      (timeline),
+        current_value (0) {
+    }
+
+    size_t DeletionQueue::collect() {
+        // Skip reading the timeline when there is nothing to destroy
+        if (retired.empty()) return 0;
+        return collect(timeline.get_value());
+    }
+
+    size_t DeletionQueue::collect(uint64_t completed_value) {
+        // Values are ordered, so finished resources always form a prefix
+        size_t count = 0;
+        while (!retired.empty() && retired.front().value <= completed_value) {
+            retired.pop_front();
+            ++count;
+        }
+        return count;
+    }
+
+    void DeletionQueue::flush() {
+        retired.clear();
+    }
+
+}}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "timeline_semaphore.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <type_traits>
+
+namespace stirling { namespace vulkan {
+
+    // Keeps released resources alive until a timeline reaches the value of the last submission that
+    // used them, so resources can be dropped mid-frame without waiting for the device to go idle.
+    // Resources are any movable wrapper or Deleter, values must not decrease between releases.
+    struct DeletionQueue {
+        DeletionQueue(const TimelineSemaphore& timeline);
+
+        // Value the submission being recorded will signal, used by releases without an explicit value
+        inline void set_current_value(uint64_t value) { current_value = value; }
+
+        template<typename Resource>
+        inline void release(Resource&& resource) {
+            release(std::forward<Resource>(resource), current_value);
+        }
+
+        template<typename Resource>
+        inline void release(Resource&& resource, uint64_t value) {
+            assert(retired.empty() || retired.back().value <= value);
+            retired.push_back({
+                .value    = value,
+                .resource = std::make_shared<std::decay_t<Resource>>(std::forward<Resource>(resource))
+            });
+        }
+
+        // Destroys resources whose value the timeline has reached, returns how many were destroyed
+        size_t collect();
+        size_t collect(uint64_t completed_value);
+
+        // Destroys every resource, only valid once the device is idle
+        void flush();
+
+        inline size_t size() const { return retired.size(); }
+
+    private:
+        struct RetiredResource {
+            uint64_t              value;
+            std::shared_ptr<void> resource;
+        };
+
+        const TimelineSemaphore&    timeline;
+        uint64_t                    current_value;
+        std::deque<RetiredResource> retired;
+    };
+
+}}
@@ -0,0 +1,96 @@
+#include "descriptor_allocator.hpp"
+#include "vulkan.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace stirling { namespace vulkan {
+
+    DescriptorAllocator::DescriptorAllocator(
+        const DescriptorAllocatorCreateInfo& create_info,
+        VkDevice                             device) :
+
+        create_info (create_info),
+        device      (device) {
+
+        create_pool(std::min(std::max(create_info.initial_sets, 1u), create_info.max_sets_per_pool));
+    }
+
+    VkDescriptorSet DescriptorAllocator::allocate(VkDescriptorSetLayout set_layout) {
+        return allocate(std::vector<VkDescriptorSetLayout>{set_layout})[0];
+    }
+
+    std::vector<VkDescriptorSet> DescriptorAllocator::allocate(
+        const std::vector<VkDescriptorSetLayout>& set_layouts) {
+
+        std::vector<VkDescriptorSet> descriptor_sets(set_layouts.size());
+        const DescriptorSetAllocateInfo allocate_info {
+            .set_layouts = set_layouts
+        };
+
+        // Move on to the next pool once the current one is exhausted, growing the chain if needed
+        while (!pools[current_pool].pool.try_allocate_descriptor_sets(allocate_info, descriptor_sets.data())) {
+            if (current_pool + 1 == pools.size()) {
+                const auto max_sets = pools[current_pool].max_sets;
+                if (pools[current_pool].allocated_sets == 0 && max_sets >= create_info.max_sets_per_pool) {
+                    throw "Descriptor sets do not fit into an empty descriptor pool.";
+                }
+                create_pool(std::min(max_sets * 2, create_info.max_sets_per_pool));
+            }
+            ++current_pool;
+        }
+
+        const auto set_count = static_cast<uint32_t>(set_layouts.size());
+        pools[current_pool].allocated_sets += set_count;
+        allocated_sets += set_count;
+        peak_allocated_sets = std::max(peak_allocated_sets, allocated_sets);
+        return descriptor_sets;
+    }
+
+    void DescriptorAllocator::reset() {
+        for (size_t i = 0; i <= current_pool; ++i) {
+            pools[i].pool.reset();
+            pools[i].allocated_sets = 0;
+        }
+        current_pool = 0;
+        allocated_sets = 0;
+    }
+
+    DescriptorAllocatorStatistics DescriptorAllocator::get_statistics() const {
+        uint32_t set_capacity = 0;
+        for (const auto& pool : pools) {
+            set_capacity += pool.max_sets;
+        }
+
+        return {
+            .pool_count          = static_cast<uint32_t>(pools.size()),
+            .set_capacity        = set_capacity,
+            .allocated_sets      = allocated_sets,
+            .peak_allocated_sets = peak_allocated_sets
+        };
+    }
+
+    void DescriptorAllocator::create_pool(uint32_t max_sets) {
+        std::vector<VkDescriptorPoolSize> pool_sizes;
+        pool_sizes.reserve(create_info.ratios.size());
+        for (const auto& ratio : create_info.ratios) {
+            pool_sizes.push_back({
+                .type            = ratio.type,
+                .descriptorCount = std::max(1u, static_cast<uint32_t>(std::ceil(ratio.ratio * max_sets)))
+            });
+        }
+
+        pools.push_back({
+            DescriptorPool{
+                {
+                    .max_sets   = max_sets,
+                    .pool_sizes = pool_sizes
+                },
+                device
+            },
+            max_sets,
+            0
+        });
+    }
+
+}}
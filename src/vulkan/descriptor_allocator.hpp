@@ -0,0 +1,62 @@
+#pragma once
+
+#include "descriptor_pool.hpp"
+#include "vulkan_structs.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+namespace stirling { namespace vulkan {
+
+    // Descriptors of a type reserved per set in every pool
+    struct DescriptorPoolRatio {
+        VkDescriptorType type;
+        float            ratio;
+    };
+
+    struct DescriptorAllocatorCreateInfo {
+        uint32_t                         initial_sets;
+        uint32_t                         max_sets_per_pool;
+        std::vector<DescriptorPoolRatio> ratios;
+    };
+
+    struct DescriptorAllocatorStatistics {
+        uint32_t pool_count;
+        uint32_t set_capacity;
+        uint32_t allocated_sets;
+        uint32_t peak_allocated_sets;
+    };
+
+    // Chains descriptor pools, growing each new pool, and recycles all of them at once with reset.
+    // Sets are never freed individually, so a frame's allocator is reset once its fence signaled.
+    struct DescriptorAllocator {
+        DescriptorAllocator(
+            const DescriptorAllocatorCreateInfo& create_info,
+            VkDevice                             device);
+
+        VkDescriptorSet allocate(VkDescriptorSetLayout set_layout);
+        std::vector<VkDescriptorSet> allocate(const std::vector<VkDescriptorSetLayout>& set_layouts);
+
+        void reset();
+
+        DescriptorAllocatorStatistics get_statistics() const;
+
+    private:
+        struct Pool {
+            DescriptorPool pool;
+            uint32_t       max_sets;
+            uint32_t       allocated_sets;
+        };
+
+        DescriptorAllocatorCreateInfo create_info;
+        VkDevice                      device;
+        std::vector<Pool>             pools;
+        size_t                        current_pool        = 0;
+        uint32_t                      allocated_sets      = 0;
+        uint32_t                      peak_allocated_sets = 0;
+
+        void create_pool(uint32_t max_sets);
+    };
+
+}}
@@ -73,4 +73,25 @@ namespace stirling { namespace vulkan {
         return descriptor_sets;
     }
 
+    bool DescriptorPool::try_allocate_descriptor_sets(
+        const DescriptorSetAllocateInfo& allocate_info,
+        VkDescriptorSet*                 descriptor_sets) const {
+
+        const VkDescriptorSetAllocateInfo vk_allocate_info {
+            .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .descriptorPool     = descriptor_pool,
+            .descriptorSetCount = static_cast<uint32_t>(allocate_info.set_layouts.size()),
+            .pSetLayouts        = allocate_info.set_layouts.data()
+        };
+
+        const auto result = vkAllocateDescriptorSets(device, &vk_allocate_info, descriptor_sets);
+        if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) return false;
+        vulkan_assert(result, "Failed to alocate descriptor sets.");
+        return true;
+    }
+
+    void DescriptorPool::reset() const {
+        vulkan_assert(vkResetDescriptorPool(device, descriptor_pool, 0), "Failed to reset descriptor pool.");
+    }
+
 }}
\ No newline at end of file
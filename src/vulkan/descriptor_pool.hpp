@@ -29,6 +29,13 @@ namespace stirling { namespace vulkan {
         std::vector<DescriptorSet> allocate_descriptor_sets(
             const DescriptorSetAllocateInfo& allocate_info) const;
 
+        // Returns false instead of throwing when the pool is exhausted, sets are freed with reset
+        bool try_allocate_descriptor_sets(
+            const DescriptorSetAllocateInfo& allocate_info,
+            VkDescriptorSet*                 descriptor_sets) const;
+
+        void reset() const;
+
     private:
         Deleter<VkDescriptorPool> descriptor_pool;
         VkDevice                  device;
@@ -0,0 +1,199 @@
+#include "descriptor_set_cache.hpp"
+#include "hash.hpp"
+#include "vulkan.hpp"
+
+#include <algorithm>
+
+namespace stirling { namespace vulkan {
+
+    namespace {
+
+        uint64_t hash_bindings(
+            VkDescriptorSetLayout                 set_layout,
+            const std::vector<DescriptorBinding>& bindings) {
+
+            const auto hash = hash_value(set_layout);
+            return hash_bytes(bindings.data(), bindings.size() * sizeof(DescriptorBinding), hash);
+        }
+
+        bool is_equal(const std::vector<DescriptorBinding>& lhs, const std::vector<DescriptorBinding>& rhs) {
+            return lhs.size() == rhs.size() &&
+                   memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(DescriptorBinding)) == 0;
+        }
+
+        bool is_image_descriptor(VkDescriptorType type) {
+            return type == VK_DESCRIPTOR_TYPE_SAMPLER ||
+                   type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER ||
+                   type == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE ||
+                   type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE ||
+                   type == VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        }
+
+    }
+
+    DescriptorSetCache::DescriptorSetCache(
+        const DescriptorAllocatorCreateInfo& create_info,
+        VkDevice                             device) :
+
+        device    (device),
+        allocator (create_info, device) {
+    }
+
+    VkDescriptorSet DescriptorSetCache::get(
+        VkDescriptorSetLayout                 set_layout,
+        const std::vector<DescriptorBinding>& bindings) {
+
+        const auto hash = hash_bindings(set_layout, bindings);
+        auto& bucket = sets[hash];
+        for (const auto& entry : bucket) {
+            if (entry.set_layout == set_layout && is_equal(entry.bindings, bindings)) {
+                return entry.descriptor_set;
+            }
+        }
+
+        // Reuse a set dropped by invalidation before allocating a new one
+        VkDescriptorSet descriptor_set;
+        auto& recycled = free_sets[set_layout];
+        if (!recycled.empty()) {
+            descriptor_set = recycled.back();
+            recycled.pop_back();
+        } else {
+            descriptor_set = allocator.allocate(set_layout);
+        }
+
+        bucket.push_back({
+            .set_layout     = set_layout,
+            .bindings       = bindings,
+            .descriptor_set = descriptor_set
+        });
+        ++set_count;
+
+        for (const auto& binding : bindings) {
+            pending_writes.push_back({
+                .descriptor_set = descriptor_set,
+                .binding        = binding
+            });
+
+            const Reference reference {
+                .hash           = hash,
+                .descriptor_set = descriptor_set
+            };
+            if (binding.buffer != VK_NULL_HANDLE) references[get_handle_key(binding.buffer)].push_back(reference);
+            if (binding.sampler != VK_NULL_HANDLE) references[get_handle_key(binding.sampler)].push_back(reference);
+            if (binding.image_view != VK_NULL_HANDLE) references[get_handle_key(binding.image_view)].push_back(reference);
+        }
+
+        return descriptor_set;
+    }
+
+    void DescriptorSetCache::flush() {
+        if (pending_writes.empty()) return;
+
+        std::vector<VkDescriptorImageInfo>  image_infos;
+        std::vector<VkDescriptorBufferInfo> buffer_infos;
+        std::vector<VkWriteDescriptorSet>   writes;
+        image_infos.reserve(pending_writes.size());
+        buffer_infos.reserve(pending_writes.size());
+        writes.reserve(pending_writes.size());
+
+        for (const auto& pending_write : pending_writes) {
+            const auto& binding = pending_write.binding;
+            VkWriteDescriptorSet write {
+                .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet          = pending_write.descriptor_set,
+                .dstBinding      = binding.binding,
+                .dstArrayElement = binding.array_element,
+                .descriptorCount = 1,
+                .descriptorType  = binding.type
+            };
+
+            // Both vectors were reserved up front, so these pointers stay valid
+            if (is_image_descriptor(binding.type)) {
+                image_infos.push_back({
+                    .sampler     = binding.sampler,
+                    .imageView   = binding.image_view,
+                    .imageLayout = binding.image_layout
+                });
+                write.pImageInfo = &image_infos.back();
+            } else {
+                buffer_infos.push_back({
+                    .buffer = binding.buffer,
+                    .offset = binding.offset,
+                    .range  = binding.range
+                });
+                write.pBufferInfo = &buffer_infos.back();
+            }
+            writes.push_back(write);
+        }
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        pending_writes.clear();
+    }
+
+    void DescriptorSetCache::invalidate_resource(uint64_t resource) {
+        const auto found = references.find(resource);
+        if (found == references.end()) return;
+
+        std::vector<VkDescriptorSet> dropped_sets;
+        for (const auto& reference : found->second) {
+            // Sets binding this resource twice are listed twice, the second lookup finds nothing
+            const auto bucket = sets.find(reference.hash);
+            if (bucket == sets.end()) continue;
+
+            auto& entries = bucket->second;
+            const auto entry = std::find_if(entries.begin(), entries.end(), [&reference](const Entry& entry) {
+                return entry.descriptor_set == reference.descriptor_set;
+            });
+            if (entry == entries.end()) continue;
+
+            // The other resources of the set still list it, prune them so references only hold live sets
+            for (const auto& binding : entry->bindings) {
+                if (binding.buffer != VK_NULL_HANDLE) remove_reference(get_handle_key(binding.buffer), resource, entry->descriptor_set);
+                if (binding.sampler != VK_NULL_HANDLE) remove_reference(get_handle_key(binding.sampler), resource, entry->descriptor_set);
+                if (binding.image_view != VK_NULL_HANDLE) remove_reference(get_handle_key(binding.image_view), resource, entry->descriptor_set);
+            }
+
+            free_sets[entry->set_layout].push_back(entry->descriptor_set);
+            dropped_sets.push_back(entry->descriptor_set);
+            entries.erase(entry);
+            if (entries.empty()) sets.erase(bucket);
+            --set_count;
+        }
+        references.erase(found);
+
+        // Queued writes of dropped sets would reference the destroyed resource
+        pending_writes.erase(
+            std::remove_if(pending_writes.begin(), pending_writes.end(), [&dropped_sets](const PendingWrite& write) {
+                return std::find(dropped_sets.begin(), dropped_sets.end(), write.descriptor_set) != dropped_sets.end();
+            }),
+            pending_writes.end()
+        );
+    }
+
+    void DescriptorSetCache::remove_reference(uint64_t resource, uint64_t invalidated, VkDescriptorSet descriptor_set) {
+        // The invalidated resource's list is erased whole once its sets are dropped
+        if (resource == invalidated) return;
+
+        const auto found = references.find(resource);
+        if (found == references.end()) return;
+
+        auto& resource_references = found->second;
+        resource_references.erase(
+            std::remove_if(resource_references.begin(), resource_references.end(), [descriptor_set](const Reference& reference) {
+                return reference.descriptor_set == descriptor_set;
+            }),
+            resource_references.end()
+        );
+        if (resource_references.empty()) references.erase(found);
+    }
+
+    void DescriptorSetCache::clear() {
+        sets.clear();
+        references.clear();
+        free_sets.clear();
+        pending_writes.clear();
+        set_count = 0;
+        allocator.reset();
+    }
+
+}}
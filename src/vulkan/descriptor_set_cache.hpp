@@ -0,0 +1,91 @@
+#pragma once
+
+#include "descriptor_allocator.hpp"
+#include "vulkan_structs.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace stirling { namespace vulkan {
+
+    // Resource written to one binding of a cached set, unused fields must be zero
+    struct DescriptorBinding {
+        uint32_t         binding;
+        VkDescriptorType type;
+        VkBuffer         buffer;
+        VkDeviceSize     offset;
+        VkDeviceSize     range;
+        VkSampler        sampler;
+        VkImageView      image_view;
+        VkImageLayout    image_layout;
+        uint32_t         array_element;
+    };
+
+    // Bindings are hashed and compared bytewise, so they must not contain padding
+    static_assert(sizeof(DescriptorBinding) == 4 * sizeof(uint32_t) + 5 * sizeof(uint64_t));
+
+    template<typename Handle>
+    inline uint64_t get_handle_key(Handle handle) {
+        uint64_t key = 0;
+        memcpy(&key, &handle, sizeof(handle));
+        return key;
+    }
+
+    // Shares one descriptor set between every user of the same layout and resources. Writes of new
+    // sets are queued and issued together by flush, which must run before the sets are bound.
+    struct DescriptorSetCache {
+        DescriptorSetCache(
+            const DescriptorAllocatorCreateInfo& create_info,
+            VkDevice                             device);
+
+        VkDescriptorSet get(
+            VkDescriptorSetLayout                 set_layout,
+            const std::vector<DescriptorBinding>& bindings);
+
+        // Issues every queued write in a single vkUpdateDescriptorSets call
+        void flush();
+
+        // Drops every set referencing the resource, call before destroying it
+        template<typename Handle>
+        inline void invalidate(Handle handle) { invalidate_resource(get_handle_key(handle)); }
+
+        void clear();
+
+        inline size_t size() const { return set_count; }
+        inline size_t get_pending_write_count() const { return pending_writes.size(); }
+        inline const DescriptorAllocator& get_allocator() const { return allocator; }
+
+    private:
+        struct Entry {
+            VkDescriptorSetLayout          set_layout;
+            std::vector<DescriptorBinding> bindings;
+            VkDescriptorSet                descriptor_set;
+        };
+
+        struct Reference {
+            uint64_t        hash;
+            VkDescriptorSet descriptor_set;
+        };
+
+        // Info structs are only built in flush, so queued writes hold no pointers
+        struct PendingWrite {
+            VkDescriptorSet   descriptor_set;
+            DescriptorBinding binding;
+        };
+
+        VkDevice                                                                device;
+        DescriptorAllocator                                                     allocator;
+        std::unordered_map<uint64_t, std::vector<Entry>>                        sets;
+        std::unordered_map<uint64_t, std::vector<Reference>>                    references;
+        std::unordered_map<VkDescriptorSetLayout, std::vector<VkDescriptorSet>> free_sets;
+        std::vector<PendingWrite>                                               pending_writes;
+        size_t                                                                  set_count = 0;
+
+        void invalidate_resource(uint64_t resource);
+        void remove_reference(uint64_t resource, uint64_t invalidated, VkDescriptorSet descriptor_set);
+    };
+
+}}
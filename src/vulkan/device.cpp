@@ -10,6 +10,7 @@ namespace stirling { namespace vulkan {
         
         const VkDeviceCreateInfo vk_create_info {
             .sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+            .pNext                   = create_info.next,
             .queueCreateInfoCount    = static_cast<uint32_t>(create_info.queues.size()),
             .pQueueCreateInfos       = cast_vector<const VkDeviceQueueCreateInfo*>(create_info.queues),
             .enabledExtensionCount   = static_cast<uint32_t>(create_info.enabled_extensions.size()),
@@ -41,6 +42,10 @@ namespace stirling { namespace vulkan {
         return {create_info, device};
     }
 
+    BindlessDescriptors Device::create_bindless_descriptors(const BindlessDescriptorsCreateInfo& create_info) const {
+        return {create_info, device};
+    }
+
     CommandPool Device::create_command_pool(const CommandPoolCreateInfo& create_info) const {
         return {create_info, device};
     }
@@ -48,12 +53,36 @@ namespace stirling { namespace vulkan {
     DescriptorPool Device::create_descriptor_pool(const DescriptorPoolCreateInfo& create_info) const {
         return {create_info, device};
     }
+
+    DescriptorAllocator Device::create_descriptor_allocator(const DescriptorAllocatorCreateInfo& create_info) const {
+        return {create_info, device};
+    }
+
+    DescriptorSetCache Device::create_descriptor_set_cache(const DescriptorAllocatorCreateInfo& create_info) const {
+        return {create_info, device};
+    }
     
+    Image Device::create_image(const ImageCreateInfo& create_info) const {
+        return {create_info, device};
+    }
+
+    QueryPool Device::create_query_pool(const QueryPoolCreateInfo& create_info) const {
+        return {create_info, device};
+    }
+
     Deleter<VkDescriptorSetLayout> Device::create_descriptor_set_layout(
         const DescriptorSetLayoutCreateInfo& create_info) const {
 
+        // Per binding flags are only chained when given
+        const VkDescriptorSetLayoutBindingFlagsCreateInfoEXT vk_binding_flags {
+            .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT,
+            .bindingCount  = static_cast<uint32_t>(create_info.binding_flags.size()),
+            .pBindingFlags = create_info.binding_flags.data()
+        };
+
         const VkDescriptorSetLayoutCreateInfo vk_create_info {
             .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            .pNext        = create_info.binding_flags.empty() ? nullptr : &vk_binding_flags,
             .flags        = create_info.flags,
             .bindingCount = static_cast<uint32_t>(create_info.bindings.size()),
             .pBindings    = create_info.bindings.data()
@@ -141,6 +170,16 @@ namespace stirling { namespace vulkan {
         );
     }
 
+    Deleter<VkSampler> Device::create_sampler(
+        const SamplerCreateInfo& create_info) const {
+
+        return vulkan::create_sampler(create_info, device);
+    }
+
+    SamplerCache Device::create_sampler_cache() const {
+        return {device};
+    }
+
     RenderPass Device::create_render_pass(
         const RenderPassCreateInfo& create_info) const {
 
@@ -183,9 +222,9 @@ namespace stirling { namespace vulkan {
     }
 
     Deleter<VkShaderModule> Device::create_shader_module(
-        const char* file_name) const {
+        const FileView& code) const {
 
-        const auto code = read_file(file_name);
+        // File views are page or allocation aligned, which satisfies SPIR-V word alignment
         return create_shader_module({
             .sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
             .codeSize = code.size(),
@@ -193,6 +232,12 @@ namespace stirling { namespace vulkan {
         });
     }
 
+    Deleter<VkShaderModule> Device::create_shader_module(
+        const char* file_name) const {
+
+        return create_shader_module(FileView{file_name});
+    }
+
     Deleter<VkFramebuffer> Device::create_framebuffer(
         const FramebufferCreateInfo& create_info) const {
 
@@ -238,6 +283,10 @@ namespace stirling { namespace vulkan {
         return semaphores;
     }
 
+    TimelineSemaphore Device::create_timeline_semaphore(uint64_t initial_value) const {
+        return {initial_value, device};
+    }
+
     Fence Device::create_fence(bool signaled) const {
         const VkFenceCreateInfo create_info = {
             .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
@@ -265,6 +314,10 @@ namespace stirling { namespace vulkan {
         return fences;
     }
 
+    FencePool Device::create_fence_pool() const {
+        return {device};
+    }
+
     Queue Device::get_queue(uint32_t queue_family, uint32_t queue_index) const {
         return vulkan::get_queue(device, queue_family, queue_index);
     }
@@ -1,13 +1,22 @@
 #pragma once
 
+#include "bindless_descriptors.hpp"
 #include "buffer.hpp"
 #include "command_pool.hpp"
 #include "deleter.hpp"
+#include "descriptor_allocator.hpp"
 #include "descriptor_pool.hpp"
+#include "descriptor_set_cache.hpp"
 #include "device_memory.hpp"
 #include "fence.hpp"
+#include "fence_pool.hpp"
+#include "file.hpp"
+#include "image.hpp"
 #include "pipeline.hpp"
+#include "query_pool.hpp"
+#include "sampler.hpp"
 #include "swapchain.hpp"
+#include "timeline_semaphore.hpp"
 #include "vulkan_structs.hpp"
 #include "queue.hpp"
 
@@ -19,11 +28,13 @@ namespace stirling { namespace vulkan {
         std::vector<DeviceQueueCreateInfo> queues;
         std::vector<const char*>           enabled_extensions;
         VkPhysicalDeviceFeatures           enabled_features;
+        const void*                        next;
     };
 
     struct DescriptorSetLayoutCreateInfo {
         VkDescriptorSetLayoutCreateFlags          flags;
         std::vector<VkDescriptorSetLayoutBinding> bindings;
+        std::vector<VkDescriptorBindingFlagsEXT>  binding_flags;
     };
 
     struct PipelineLayoutCreateInfo {
@@ -31,6 +42,16 @@ namespace stirling { namespace vulkan {
         std::vector<VkPushConstantRange>   push_constant_ranges;
     };
 
+    // Range covering a push constant struct, matching CommandBuffer::push_constants<T>
+    template<typename T>
+    inline VkPushConstantRange get_push_constant_range(VkShaderStageFlags stage_flags, uint32_t offset = 0) {
+        return {
+            .stageFlags = stage_flags,
+            .offset     = offset,
+            .size       = sizeof(T)
+        };
+    }
+
     struct ImageViewCreateInfo {
         VkImage                 image;
         VkImageViewType         view_type;
@@ -65,24 +86,34 @@ namespace stirling { namespace vulkan {
         DeviceMemory allocate_memory(const MemoryAllocateInfo& allocate_info) const;
         
         Buffer create_buffer(const BufferCreateInfo& create_info) const;
+        BindlessDescriptors create_bindless_descriptors(const BindlessDescriptorsCreateInfo& create_info) const;
         CommandPool create_command_pool(const CommandPoolCreateInfo& create_info) const;
         DescriptorPool create_descriptor_pool(const DescriptorPoolCreateInfo& create_info) const;
+        DescriptorAllocator create_descriptor_allocator(const DescriptorAllocatorCreateInfo& create_info) const;
+        DescriptorSetCache create_descriptor_set_cache(const DescriptorAllocatorCreateInfo& create_info) const;
+        Image create_image(const ImageCreateInfo& create_info) const;
+        QueryPool create_query_pool(const QueryPoolCreateInfo& create_info) const;
         Swapchain create_swapchain(const SwapchainCreateInfo& create_info) const;
         Deleter<VkDescriptorSetLayout> create_descriptor_set_layout(
             const DescriptorSetLayoutCreateInfo& create_info) const;
         Deleter<VkPipelineLayout> create_pipeline_layout(const PipelineLayoutCreateInfo& create_info) const;
         Deleter<VkImageView> create_image_view(const ImageViewCreateInfo& create_info) const;
+        Deleter<VkSampler> create_sampler(const SamplerCreateInfo& create_info) const;
+        SamplerCache create_sampler_cache() const;
         RenderPass create_render_pass(const RenderPassCreateInfo& create_info) const;
         Pipeline create_pipeline(
             const GraphicsPipelineCreateInfo& create_info,
             VkPipelineCache                   pipeline_cache) const;
         Deleter<VkShaderModule> create_shader_module(const VkShaderModuleCreateInfo& create_info) const;
+        Deleter<VkShaderModule> create_shader_module(const FileView& code) const;
         Deleter<VkShaderModule> create_shader_module(const char* file_name) const;
         Deleter<VkFramebuffer> create_framebuffer(const FramebufferCreateInfo& create_info) const;
         Deleter<VkSemaphore> create_semaphore() const;
         std::vector<Deleter<VkSemaphore>> create_semaphores(size_t count) const;
+        TimelineSemaphore create_timeline_semaphore(uint64_t initial_value = 0) const;
         Fence create_fence(bool signaled = false) const;
         std::vector<Fence> create_fences(size_t count, bool signaled = false) const;
+        FencePool create_fence_pool() const;
 
         void update_descriptor_sets(
             const std::vector<WriteDescriptorSet>& descriptor_writes,
@@ -51,8 +51,8 @@ namespace stirling { namespace vulkan {
         if (data) deleter();
     }
 
-    void DeviceMemoryMapping::copy(const void* src, size_t size) {
-        memcpy(data, src, size);
+    void DeviceMemoryMapping::copy(const void* src, size_t size, size_t offset) {
+        memcpy(static_cast<uint8_t*>(data) + offset, src, size);
     }
 
 }}
\ No newline at end of file
@@ -26,7 +26,9 @@ namespace stirling { namespace vulkan {
         DeviceMemoryMapping(DeviceMemoryMapping&&) = default;
         DeviceMemoryMapping& operator=(DeviceMemoryMapping&&) = default;
 
-        void copy(const void* src, size_t size);
+        inline void* get() const { return data; }
+
+        void copy(const void* src, size_t size, size_t offset = 0);
 
     private:
         void*                 data;
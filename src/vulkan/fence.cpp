@@ -8,12 +8,16 @@ namespace stirling { namespace vulkan {
         device (device) {
     }
 
-    void Fence::wait() const {
-        vulkan::wait_for_fence(device, fence);
+    bool Fence::wait(uint64_t timeout) const {
+        return vulkan::wait_for_fence(device, fence, timeout);
     }
 
     void Fence::reset() const {
         vulkan::reset_fence(device, fence);
     }
 
+    bool Fence::is_signaled() const {
+        return vulkan::get_fence_status(device, fence);
+    }
+
 }}
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 #include <vulkan/vulkan.h>
 
+#include <limits>
+
 namespace stirling { namespace vulkan {
 
     struct Fence {
@@ -12,8 +14,10 @@ namespace stirling { namespace vulkan {
 
         inline operator const VkFence() const { return fence; }
 
-        void wait() const;
+        // Returns false if the timeout expired first
+        bool wait(uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
         void reset() const;
+        bool is_signaled() const;
 
     private:
         Deleter<VkFence> fence;
@@ -0,0 +1,59 @@
+#include "fence_pool.hpp"
+#include "vulkan.hpp"
+#include "vulkan_create.hpp"
+
+namespace stirling { namespace vulkan {
+
+    inline Deleter<VkFence> create_fence(VkDevice device) {
+        const VkFenceCreateInfo create_info = {
+            .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO
+        };
+
+        return create<VkFence>(
+            vkCreateFence,
+            vkDestroyFence,
+            device,
+            "Failed to create fence.",
+            &create_info
+        );
+    }
+
+    FencePool::FencePool(VkDevice device) :
+        device (device) {
+    }
+
+    VkFence FencePool::acquire() {
+        // Reset every released fence at once before creating new ones
+        if (available_fences.empty() && !released_fences.empty()) {
+            reset_fence(device, released_fences);
+            available_fences.swap(released_fences);
+        }
+
+        if (available_fences.empty()) {
+            fences.push_back(create_fence(device));
+            return fences.back();
+        }
+
+        const auto fence = available_fences.back();
+        available_fences.pop_back();
+        return fence;
+    }
+
+    void FencePool::release(VkFence fence) {
+        released_fences.push_back(fence);
+    }
+
+    bool FencePool::is_signaled(VkFence fence) const {
+        return get_fence_status(device, fence);
+    }
+
+    bool FencePool::wait(
+        Span<VkFence> fences,
+        bool          wait_all,
+        uint64_t      timeout) const {
+
+        if (fences.empty()) return true;
+        return wait_for_fence(device, fences, wait_all ? VK_TRUE : VK_FALSE, timeout);
+    }
+
+}}
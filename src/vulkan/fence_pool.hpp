@@ -0,0 +1,41 @@
+#pragma once
+
+#include "deleter.hpp"
+#include "vulkan_helpers.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <limits>
+#include <vector>
+
+namespace stirling { namespace vulkan {
+
+    // Recycles fences instead of creating one per submission. Released fences are reset together
+    // with a single vkResetFences call the next time the pool runs out of unsignaled fences.
+    struct FencePool {
+        FencePool(VkDevice device);
+
+        // Returns an unsignaled fence owned by the pool
+        VkFence acquire();
+
+        // Returns a fence to the pool, it must be signaled or never have been submitted
+        void release(VkFence fence);
+
+        bool is_signaled(VkFence fence) const;
+
+        // Waits for all or any of the fences with a single call, returns false on timeout
+        bool wait(
+            Span<VkFence> fences,
+            bool          wait_all = true,
+            uint64_t      timeout  = std::numeric_limits<uint64_t>::max()) const;
+
+        inline size_t size() const { return fences.size(); }
+
+    private:
+        VkDevice                      device;
+        std::vector<Deleter<VkFence>> fences;
+        std::vector<VkFence>          available_fences;
+        std::vector<VkFence>          released_fences;
+    };
+
+}}
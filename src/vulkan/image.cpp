@@ -0,0 +1,53 @@
+#include "image.hpp"
+#include "vulkan.hpp"
+#include "vulkan_create.hpp"
+
+namespace stirling { namespace vulkan {
+
+    inline Deleter<VkImage> create_image(
+        const ImageCreateInfo& create_info,
+        VkDevice               device) {
+
+        const VkImageCreateInfo vk_create_info {
+            .sType                 = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .flags                 = create_info.flags,
+            .imageType             = create_info.image_type,
+            .format                = create_info.format,
+            .extent                = create_info.extent,
+            .mipLevels             = create_info.mip_levels,
+            .arrayLayers           = create_info.array_layers,
+            .samples               = create_info.samples,
+            .tiling                = create_info.tiling,
+            .usage                 = create_info.usage,
+            .sharingMode           = create_info.sharing_mode,
+            .queueFamilyIndexCount = static_cast<uint32_t>(create_info.queue_family_indices.size()),
+            .pQueueFamilyIndices   = create_info.queue_family_indices.data(),
+            .initialLayout         = create_info.initial_layout
+        };
+
+        return create<VkImage>(
+            vkCreateImage,
+            vkDestroyImage,
+            device,
+            "Failed to create image.",
+            &vk_create_info
+        );
+    }
+
+    Image::Image(
+        const ImageCreateInfo& create_info,
+        VkDevice               device) :
+
+        image  (create_image(create_info, device)),
+        device (device) {
+    }
+
+    void Image::bind(VkDeviceMemory memory, VkDeviceSize offset) const {
+        vkBindImageMemory(device, image, memory, offset);
+    }
+
+    MemoryRequirements Image::get_memory_requirements() const {
+        return vulkan::get_image_memory_requirements(device, image);
+    }
+
+}}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "deleter.hpp"
+#include "vulkan.hpp"
+#include "vulkan_structs.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace stirling { namespace vulkan {
+
+    struct ImageCreateInfo {
+        VkImageCreateFlags    flags;
+        VkImageType           image_type;
+        VkFormat              format;
+        VkExtent3D            extent;
+        uint32_t              mip_levels;
+        uint32_t              array_layers;
+        VkSampleCountFlagBits samples;
+        VkImageTiling         tiling;
+        VkImageUsageFlags     usage;
+        VkSharingMode         sharing_mode;
+        std::vector<uint32_t> queue_family_indices;
+        VkImageLayout         initial_layout;
+    };
+
+    struct Image {
+        Image(
+            const ImageCreateInfo& create_info,
+            VkDevice               device);
+
+        inline operator const VkImage() const { return image; }
+
+        void bind(VkDeviceMemory memory, VkDeviceSize offset) const;
+
+        vulkan::MemoryRequirements get_memory_requirements() const;
+
+    private:
+        Deleter<VkImage> image;
+        VkDevice         device;
+    };
+
+}}
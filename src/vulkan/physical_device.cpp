@@ -1,6 +1,8 @@
 #include "physical_device.hpp"
 #include "vulkan.hpp"
 
+#include <cstring>
+
 namespace stirling { namespace vulkan {
 
     PhysicalDevice::PhysicalDevice(VkPhysicalDevice physical_device) :
@@ -19,6 +21,29 @@ namespace stirling { namespace vulkan {
         return vulkan::get_physical_device_features(physical_device);
     }
 
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT PhysicalDevice::get_descriptor_indexing_features() const {
+        return vulkan::get_physical_device_descriptor_indexing_features(physical_device);
+    }
+
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT PhysicalDevice::get_descriptor_indexing_properties() const {
+        return vulkan::get_physical_device_descriptor_indexing_properties(physical_device);
+    }
+
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR PhysicalDevice::get_timeline_semaphore_features() const {
+        return vulkan::get_physical_device_timeline_semaphore_features(physical_device);
+    }
+
+    bool PhysicalDevice::supports_extension(const char* extension_name) const {
+        for (const auto& extension : vulkan::get_device_extension_properties(physical_device)) {
+            if (strcmp(extension.extensionName, extension_name) == 0) return true;
+        }
+        return false;
+    }
+
+    VkFormatProperties PhysicalDevice::get_format_properties(VkFormat format) const {
+        return vulkan::get_physical_device_format_properties(physical_device, format);
+    }
+
     QueueFamilyIndices PhysicalDevice::get_queue_families(const Surface& surface) const {
         return vulkan::get_queue_families(physical_device, surface);
     }
@@ -17,6 +17,11 @@ namespace stirling { namespace vulkan {
 
         VkPhysicalDeviceProperties get_properties() const;
         VkPhysicalDeviceFeatures get_features() const;
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT get_descriptor_indexing_features() const;
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT get_descriptor_indexing_properties() const;
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR get_timeline_semaphore_features() const;
+        bool supports_extension(const char* extension_name) const;
+        VkFormatProperties get_format_properties(VkFormat format) const;
         QueueFamilyIndices get_queue_families(const Surface& surface) const;
         uint32_t find_memory_type(uint32_t type_filter, VkMemoryPropertyFlags properties) const;
 
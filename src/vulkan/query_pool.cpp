@@ -0,0 +1,62 @@
+#include "query_pool.hpp"
+#include "vulkan.hpp"
+#include "vulkan_create.hpp"
+
+#include <bitset>
+
+namespace stirling { namespace vulkan {
+
+    inline Deleter<VkQueryPool> create_query_pool(
+        const QueryPoolCreateInfo& create_info,
+        VkDevice                   device) {
+
+        const VkQueryPoolCreateInfo vk_create_info {
+            .sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .queryType          = create_info.query_type,
+            .queryCount         = create_info.query_count,
+            .pipelineStatistics = create_info.pipeline_statistics
+        };
+
+        return create<VkQueryPool>(
+            vkCreateQueryPool,
+            vkDestroyQueryPool,
+            device,
+            "Failed to create query pool.",
+            &vk_create_info
+        );
+    }
+
+    QueryPool::QueryPool(
+        const QueryPoolCreateInfo& create_info,
+        VkDevice                   device) :
+
+        query_pool  (create_query_pool(create_info, device)),
+        device      (device),
+        value_count (create_info.query_type == VK_QUERY_TYPE_PIPELINE_STATISTICS
+            ? static_cast<uint32_t>(std::bitset<32>(create_info.pipeline_statistics).count())
+            : 1) {
+    }
+
+    bool QueryPool::get_results(
+        uint32_t           first_query,
+        uint32_t           query_count,
+        uint64_t*          results,
+        VkQueryResultFlags flags) const {
+
+        const auto stride = value_count * sizeof(uint64_t);
+        const auto result = vkGetQueryPoolResults(
+            device,
+            query_pool,
+            first_query,
+            query_count,
+            query_count * stride,
+            results,
+            stride,
+            flags | VK_QUERY_RESULT_64_BIT
+        );
+        if (result == VK_NOT_READY) return false;
+        vulkan_assert(result, "Failed to get query pool results.");
+        return true;
+    }
+
+}}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "deleter.hpp"
+#include "vulkan_structs.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace stirling { namespace vulkan {
+
+    struct QueryPoolCreateInfo {
+        VkQueryType                   query_type;
+        uint32_t                      query_count;
+        VkQueryPipelineStatisticFlags pipeline_statistics;
+    };
+
+    struct QueryPool {
+        QueryPool(
+            const QueryPoolCreateInfo& create_info,
+            VkDevice                   device);
+
+        inline operator const VkQueryPool() const { return query_pool; }
+
+        // Number of 64-bit values written per query, one per enabled pipeline statistic
+        inline uint32_t get_value_count() const { return value_count; }
+
+        // Returns false without blocking if any of the queries is not yet available
+        bool get_results(
+            uint32_t           first_query,
+            uint32_t           query_count,
+            uint64_t*          results,
+            VkQueryResultFlags flags = 0) const;
+
+    private:
+        Deleter<VkQueryPool> query_pool;
+        VkDevice             device;
+        uint32_t             value_count;
+    };
+
+}}
@@ -6,7 +6,7 @@ namespace stirling { namespace vulkan {
         queue (queue) {
     }
 
-    void Queue::submit(const std::vector<SubmitInfo>& submit_infos, VkFence fence) const {
+    void Queue::submit(Span<SubmitInfo> submit_infos, VkFence fence) const {
         queue_submit(submit_infos, queue, fence);
     }
 
@@ -12,7 +12,7 @@ namespace stirling { namespace vulkan {
 
         inline operator const VkQueue() const { return queue; }
     
-        void submit(const std::vector<SubmitInfo>& submit_infos, VkFence fence = VK_NULL_HANDLE) const;
+        void submit(Span<SubmitInfo> submit_infos, VkFence fence = VK_NULL_HANDLE) const;
         void present(const PresentInfoKHR& present_info) const;
         void wait_idle() const;
 
@@ -0,0 +1,72 @@
+#include "sampler.hpp"
+#include "hash.hpp"
+#include "vulkan.hpp"
+#include "vulkan_create.hpp"
+
+#include <cstring>
+
+namespace stirling { namespace vulkan {
+
+    Deleter<VkSampler> create_sampler(
+        const SamplerCreateInfo& create_info,
+        VkDevice                 device) {
+
+        const VkSamplerCreateInfo vk_create_info {
+            .sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+            .flags                   = create_info.flags,
+            .magFilter               = create_info.mag_filter,
+            .minFilter               = create_info.min_filter,
+            .mipmapMode              = create_info.mipmap_mode,
+            .addressModeU            = create_info.address_mode_u,
+            .addressModeV            = create_info.address_mode_v,
+            .addressModeW            = create_info.address_mode_w,
+            .mipLodBias              = create_info.mip_lod_bias,
+            .anisotropyEnable        = create_info.anisotropy_enable,
+            .maxAnisotropy           = create_info.max_anisotropy,
+            .compareEnable           = create_info.compare_enable,
+            .compareOp               = create_info.compare_op,
+            .minLod                  = create_info.min_lod,
+            .maxLod                  = create_info.max_lod,
+            .borderColor             = create_info.border_color,
+            .unnormalizedCoordinates = create_info.unnormalized_coordinates
+        };
+
+        return create<VkSampler>(
+            vkCreateSampler,
+            vkDestroySampler,
+            device,
+            "Failed to create sampler.",
+            &vk_create_info
+        );
+    }
+
+    SamplerCache::SamplerCache(VkDevice device) :
+        device (device) {
+    }
+
+    VkSampler SamplerCache::get(const SamplerCreateInfo& create_info) {
+        // Samplers are immutable, so identical create infos can share one handle
+        auto it = samplers.find(create_info);
+        if (it == samplers.end()) {
+            it = samplers.emplace(create_info, create_sampler(create_info, device)).first;
+        }
+        return it->second;
+    }
+
+    size_t SamplerCache::size() const {
+        return samplers.size();
+    }
+
+    void SamplerCache::clear() {
+        samplers.clear();
+    }
+
+    size_t SamplerCache::Hash::operator()(const SamplerCreateInfo& create_info) const {
+        return static_cast<size_t>(hash_value(create_info));
+    }
+
+    bool SamplerCache::Equal::operator()(const SamplerCreateInfo& lhs, const SamplerCreateInfo& rhs) const {
+        return memcmp(&lhs, &rhs, sizeof(SamplerCreateInfo)) == 0;
+    }
+
+}}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "deleter.hpp"
+#include "vulkan_structs.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <unordered_map>
+
+namespace stirling { namespace vulkan {
+
+    struct SamplerCreateInfo {
+        VkSamplerCreateFlags flags;
+        VkFilter             mag_filter;
+        VkFilter             min_filter;
+        VkSamplerMipmapMode  mipmap_mode;
+        VkSamplerAddressMode address_mode_u;
+        VkSamplerAddressMode address_mode_v;
+        VkSamplerAddressMode address_mode_w;
+        float                mip_lod_bias;
+        VkBool32             anisotropy_enable;
+        float                max_anisotropy;
+        VkBool32             compare_enable;
+        VkCompareOp          compare_op;
+        float                min_lod;
+        float                max_lod;
+        VkBorderColor        border_color;
+        VkBool32             unnormalized_coordinates;
+    };
+
+    // Sampler create infos are hashed and compared bytewise, so they must not contain padding
+    static_assert(sizeof(SamplerCreateInfo) == 16 * sizeof(uint32_t));
+
+    Deleter<VkSampler> create_sampler(
+        const SamplerCreateInfo& create_info,
+        VkDevice                 device);
+
+    struct SamplerCache {
+        SamplerCache(VkDevice device);
+
+        VkSampler get(const SamplerCreateInfo& create_info);
+
+        size_t size() const;
+        void clear();
+
+    private:
+        struct Hash {
+            size_t operator()(const SamplerCreateInfo& create_info) const;
+        };
+
+        struct Equal {
+            bool operator()(const SamplerCreateInfo& lhs, const SamplerCreateInfo& rhs) const;
+        };
+
+        std::unordered_map<SamplerCreateInfo, Deleter<VkSampler>, Hash, Equal> samplers;
+        VkDevice                                                              device;
+    };
+
+}}
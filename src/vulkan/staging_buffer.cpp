@@ -0,0 +1,41 @@
+#include "staging_buffer.hpp"
+#include "vulkan.hpp"
+
+namespace stirling { namespace vulkan {
+
+    inline DeviceMemory allocate_staging_memory(
+        const Buffer&         buffer,
+        const PhysicalDevice& physical_device,
+        const Device&         device) {
+
+        const auto memory_requirements = buffer.get_memory_requirements();
+        return device.allocate_memory({
+            .allocation_size   = memory_requirements.size,
+            .memory_type_index = physical_device.find_memory_type(
+                memory_requirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            )
+        });
+    }
+
+    StagingBuffer::StagingBuffer(
+        VkDeviceSize          size,
+        const PhysicalDevice& physical_device,
+        const Device&         device) :
+
+        buffer      (device.create_buffer({
+            .size         = size,
+            .usage        = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            .sharing_mode = VK_SHARING_MODE_EXCLUSIVE
+        })),
+        memory      (allocate_staging_memory(buffer, physical_device, device)),
+        buffer_size (size) {
+
+        buffer.bind(memory, 0);
+    }
+
+    DeviceMemoryMapping StagingBuffer::map() const {
+        return memory.map(0, buffer_size);
+    }
+
+}}
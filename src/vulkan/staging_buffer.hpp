@@ -0,0 +1,30 @@
+#pragma once
+
+#include "buffer.hpp"
+#include "device.hpp"
+#include "device_memory.hpp"
+#include "physical_device.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace stirling { namespace vulkan {
+
+    struct StagingBuffer {
+        StagingBuffer(
+            VkDeviceSize          size,
+            const PhysicalDevice& physical_device,
+            const Device&         device);
+
+        inline operator const VkBuffer() const { return buffer; }
+
+        inline VkDeviceSize size() const { return buffer_size; }
+
+        DeviceMemoryMapping map() const;
+
+    private:
+        Buffer       buffer;
+        DeviceMemory memory;
+        VkDeviceSize buffer_size;
+    };
+
+}}
@@ -0,0 +1,75 @@
+#include "timeline_semaphore.hpp"
+#include "vulkan.hpp"
+#include "vulkan_create.hpp"
+
+namespace stirling { namespace vulkan {
+
+    inline Deleter<VkSemaphore> create_timeline_semaphore(
+        uint64_t initial_value,
+        VkDevice device) {
+
+        const VkSemaphoreTypeCreateInfoKHR type_create_info = {
+            .sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR,
+            .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR,
+            .initialValue  = initial_value
+        };
+        const VkSemaphoreCreateInfo create_info = {
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+            .pNext = &type_create_info
+        };
+
+        return create<VkSemaphore>(
+            vkCreateSemaphore,
+            vkDestroySemaphore,
+            device,
+            "Failed to create timeline semaphore.",
+            &create_info
+        );
+    }
+
+    template<typename Function>
+    inline Function get_device_function(VkDevice device, const char* name) {
+        const auto function = reinterpret_cast<Function>(vkGetDeviceProcAddr(device, name));
+        if (function == nullptr) throw "Timeline semaphore extension not present.";
+        return function;
+    }
+
+    TimelineSemaphore::TimelineSemaphore(uint64_t initial_value, VkDevice device) :
+        semaphore                   (create_timeline_semaphore(initial_value, device)),
+        device                      (device),
+        get_semaphore_counter_value (get_device_function<PFN_vkGetSemaphoreCounterValueKHR>(device, "vkGetSemaphoreCounterValueKHR")),
+        wait_semaphores             (get_device_function<PFN_vkWaitSemaphoresKHR>(device, "vkWaitSemaphoresKHR")),
+        signal_semaphore            (get_device_function<PFN_vkSignalSemaphoreKHR>(device, "vkSignalSemaphoreKHR")) {
+    }
+
+    uint64_t TimelineSemaphore::get_value() const {
+        uint64_t value;
+        vulkan_assert(get_semaphore_counter_value(device, semaphore, &value), "Failed to get semaphore value.");
+        return value;
+    }
+
+    bool TimelineSemaphore::wait(uint64_t value, uint64_t timeout) const {
+        const VkSemaphore semaphores[] = { semaphore };
+        const VkSemaphoreWaitInfoKHR wait_info = {
+            .sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR,
+            .semaphoreCount = 1,
+            .pSemaphores    = semaphores,
+            .pValues        = &value
+        };
+
+        const auto result = wait_semaphores(device, &wait_info, timeout);
+        if (result == VK_TIMEOUT) return false;
+        vulkan_assert(result, "Failed to wait for semaphore.");
+        return true;
+    }
+
+    void TimelineSemaphore::signal(uint64_t value) const {
+        const VkSemaphoreSignalInfoKHR signal_info = {
+            .sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR,
+            .semaphore = semaphore,
+            .value     = value
+        };
+        vulkan_assert(signal_semaphore(device, &signal_info), "Failed to signal semaphore.");
+    }
+
+}}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "deleter.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <limits>
+
+namespace stirling { namespace vulkan {
+
+    // Semaphore holding a monotonically increasing 64-bit value. Submissions signal and wait for
+    // values, and the host can read, wait for and signal them directly, so a single semaphore
+    // tracks the completion of any number of frames or uploads without fences.
+    struct TimelineSemaphore {
+        TimelineSemaphore(uint64_t initial_value, VkDevice device);
+
+        inline operator const VkSemaphore() const { return semaphore; }
+
+        uint64_t get_value() const;
+        inline bool is_reached(uint64_t value) const { return get_value() >= value; }
+
+        // Returns false if the value was not reached within the timeout
+        bool wait(uint64_t value, uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
+        void signal(uint64_t value) const;
+
+    private:
+        Deleter<VkSemaphore>              semaphore;
+        VkDevice                          device;
+        PFN_vkGetSemaphoreCounterValueKHR get_semaphore_counter_value;
+        PFN_vkWaitSemaphoresKHR           wait_semaphores;
+        PFN_vkSignalSemaphoreKHR          signal_semaphore;
+    };
+
+}}
@@ -24,6 +24,7 @@ namespace stirling { namespace vulkan {
     using Extent2D = VkExtent2D;
     using RenderPass = Deleter<VkRenderPass>;
     using MemoryRequirements = VkMemoryRequirements;
+    using Sampler = Deleter<VkSampler>;
 
     inline void free_command_buffer(
         VkDevice        device,
@@ -42,9 +43,9 @@ namespace stirling { namespace vulkan {
     }
 
     inline void update_descriptor_sets(
-        VkDevice                               device,
-        const std::vector<WriteDescriptorSet>& descriptor_writes,
-        const std::vector<CopyDescriptorSet>&  descriptor_copies) {
+        VkDevice                 device,
+        Span<WriteDescriptorSet> descriptor_writes,
+        Span<CopyDescriptorSet>  descriptor_copies) {
 
         vkUpdateDescriptorSets(
             device,
@@ -56,10 +57,10 @@ namespace stirling { namespace vulkan {
     }
 
     inline void cmd_copy_buffer(
-        VkCommandBuffer                  command_buffer,
-        VkBuffer                         src_buffer,
-        VkBuffer                         dst_buffer,
-        const std::vector<VkBufferCopy>& regions) {
+        VkCommandBuffer    command_buffer,
+        VkBuffer           src_buffer,
+        VkBuffer           dst_buffer,
+        Span<VkBufferCopy> regions) {
 
         vkCmdCopyBuffer(
             command_buffer,
@@ -70,19 +71,106 @@ namespace stirling { namespace vulkan {
         );
     }
 
+    inline void cmd_copy_buffer_to_image(
+        VkCommandBuffer         command_buffer,
+        VkBuffer                src_buffer,
+        VkImage                 dst_image,
+        VkImageLayout           dst_image_layout,
+        Span<VkBufferImageCopy> regions) {
+
+        vkCmdCopyBufferToImage(
+            command_buffer,
+            src_buffer,
+            dst_image,
+            dst_image_layout,
+            static_cast<uint32_t>(regions.size()),
+            regions.data()
+        );
+    }
+
+    inline void cmd_blit_image(
+        VkCommandBuffer   command_buffer,
+        VkImage           src_image,
+        VkImageLayout     src_image_layout,
+        VkImage           dst_image,
+        VkImageLayout     dst_image_layout,
+        Span<VkImageBlit> regions,
+        VkFilter          filter) {
+
+        vkCmdBlitImage(
+            command_buffer,
+            src_image,
+            src_image_layout,
+            dst_image,
+            dst_image_layout,
+            static_cast<uint32_t>(regions.size()),
+            regions.data(),
+            filter
+        );
+    }
+
+    inline void cmd_pipeline_barrier(
+        VkCommandBuffer             command_buffer,
+        VkPipelineStageFlags        src_stage_mask,
+        VkPipelineStageFlags        dst_stage_mask,
+        VkDependencyFlags           dependency_flags,
+        Span<VkMemoryBarrier>       memory_barriers,
+        Span<VkBufferMemoryBarrier> buffer_memory_barriers,
+        Span<VkImageMemoryBarrier>  image_memory_barriers) {
+
+        vkCmdPipelineBarrier(
+            command_buffer,
+            src_stage_mask,
+            dst_stage_mask,
+            dependency_flags,
+            static_cast<uint32_t>(memory_barriers.size()),
+            memory_barriers.data(),
+            static_cast<uint32_t>(buffer_memory_barriers.size()),
+            buffer_memory_barriers.data(),
+            static_cast<uint32_t>(image_memory_barriers.size()),
+            image_memory_barriers.data()
+        );
+    }
+
+    inline void cmd_set_viewport(
+        VkCommandBuffer  command_buffer,
+        uint32_t         first_viewport,
+        Span<VkViewport> viewports) {
+
+        vkCmdSetViewport(
+            command_buffer,
+            first_viewport,
+            static_cast<uint32_t>(viewports.size()),
+            viewports.data()
+        );
+    }
+
+    inline void cmd_set_scissor(
+        VkCommandBuffer command_buffer,
+        uint32_t        first_scissor,
+        Span<VkRect2D>  scissors) {
+
+        vkCmdSetScissor(
+            command_buffer,
+            first_scissor,
+            static_cast<uint32_t>(scissors.size()),
+            scissors.data()
+        );
+    }
+
     inline void cmd_bind_vertex_buffers(
-        VkCommandBuffer                  command_buffer,
-        uint32_t                         first_binding,
-        const std::vector<VkBuffer>&     buffers,
-        const std::vector<VkDeviceSize>& offsets) {
+        VkCommandBuffer    command_buffer,
+        uint32_t           first_binding,
+        Span<VkBuffer>     buffers,
+        Span<VkDeviceSize> offsets) {
 
         assert(buffers.size() == offsets.size());
         vkCmdBindVertexBuffers(
             command_buffer,
             first_binding,
-            buffers.size(),
-            buffers.data(),
-            offsets.data()
+            static_cast<uint32_t>(buffers.size()),
+            buffers.begin(),
+            offsets.begin()
         );
     }
 
@@ -101,12 +189,12 @@ namespace stirling { namespace vulkan {
     }
 
     inline void cmd_bind_descriptor_sets(
-        VkCommandBuffer              command_buffer,
-        VkPipelineBindPoint          pipeline_bind_point,
-        VkPipelineLayout             layout,
-        uint32_t                     first_set,
-        std::vector<VkDescriptorSet> descriptor_sets,
-        std::vector<uint32_t>        dynamic_offsets) {
+        VkCommandBuffer       command_buffer,
+        VkPipelineBindPoint   pipeline_bind_point,
+        VkPipelineLayout      layout,
+        uint32_t              first_set,
+        Span<VkDescriptorSet> descriptor_sets,
+        Span<uint32_t>        dynamic_offsets) {
 
         vkCmdBindDescriptorSets(
             command_buffer,
@@ -114,9 +202,9 @@ namespace stirling { namespace vulkan {
             layout,
             first_set,
             static_cast<uint32_t>(descriptor_sets.size()),
-            descriptor_sets.data(),
+            descriptor_sets.begin(),
             static_cast<uint32_t>(dynamic_offsets.size()),
-            dynamic_offsets.data()
+            dynamic_offsets.begin()
         );
     }
 
@@ -147,33 +235,43 @@ namespace stirling { namespace vulkan {
         vkCmdBeginRenderPass(command_buffer, begin_info, contents);
     }
 
-    inline void wait_for_fence(
-        VkDevice             device,
-        std::vector<VkFence> fences,
-        VkBool32             wait_all = VK_TRUE,
-        uint64_t             timeout = std::numeric_limits<uint64_t>::max()) {
-
-        vulkan_assert(
-            vkWaitForFences(device, fences.size(), fences.data(), wait_all, timeout),
-            "Failed to wait for fences."
-        );
+    // Returns false if the timeout expired before the fences were signaled
+    inline bool wait_for_fence(
+        VkDevice      device,
+        Span<VkFence> fences,
+        VkBool32      wait_all = VK_TRUE,
+        uint64_t      timeout = std::numeric_limits<uint64_t>::max()) {
+
+        const auto result = vkWaitForFences(device, static_cast<uint32_t>(fences.size()), fences.data(), wait_all, timeout);
+        if (result == VK_TIMEOUT) return false;
+        vulkan_assert(result, "Failed to wait for fences.");
+        return true;
     }
 
-    inline void wait_for_fence(
+    inline bool wait_for_fence(
         VkDevice device,
         VkFence  fence,
-        VkBool32 wait_all = VK_TRUE,
         uint64_t timeout = std::numeric_limits<uint64_t>::max()) {
 
-        vulkan_assert(
-            vkWaitForFences(device, 1, &fence, wait_all, timeout),
-            "Failed to wait for fence."
-        );
+        const auto result = vkWaitForFences(device, 1, &fence, VK_TRUE, timeout);
+        if (result == VK_TIMEOUT) return false;
+        vulkan_assert(result, "Failed to wait for fence.");
+        return true;
+    }
+
+    inline bool get_fence_status(
+        VkDevice device,
+        VkFence  fence) {
+
+        const auto result = vkGetFenceStatus(device, fence);
+        if (result == VK_NOT_READY) return false;
+        vulkan_assert(result, "Failed to get fence status.");
+        return true;
     }
 
     inline void reset_fence(
-        VkDevice             device,
-        std::vector<VkFence> fences) {
+        VkDevice      device,
+        Span<VkFence> fences) {
 
         vulkan_assert(
             vkResetFences(device, fences.size(), fences.data()),
@@ -204,9 +302,9 @@ namespace stirling { namespace vulkan {
     }
 
     inline void queue_submit(
-        const std::vector<SubmitInfo>& submit_infos,
-        VkQueue                        queue,
-        VkFence                        fence = VK_NULL_HANDLE) {
+        Span<SubmitInfo> submit_infos,
+        VkQueue          queue,
+        VkFence          fence = VK_NULL_HANDLE) {
         
         vulkan_assert(
             vkQueueSubmit(
@@ -261,6 +359,70 @@ namespace stirling { namespace vulkan {
         return features;
     }
 
+    inline std::vector<VkExtensionProperties> get_device_extension_properties(
+        VkPhysicalDevice physical_device) {
+
+        // Get number of device extensions
+        uint32_t extension_count = 0;
+        vulkan_assert(
+            vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &extension_count, nullptr),
+            "Failed to get number of device extensions."
+        );
+
+        // Get device extensions
+        std::vector<VkExtensionProperties> extensions{extension_count};
+        vulkan_assert(
+            vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &extension_count, extensions.data()),
+            "Failed to get device extensions."
+        );
+        return extensions;
+    }
+
+    inline VkPhysicalDeviceDescriptorIndexingFeaturesEXT get_physical_device_descriptor_indexing_features(
+        VkPhysicalDevice physical_device) {
+
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexing_features {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT
+        };
+        VkPhysicalDeviceFeatures2 features {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            .pNext = &indexing_features
+        };
+        vkGetPhysicalDeviceFeatures2(physical_device, &features);
+        indexing_features.pNext = nullptr;
+        return indexing_features;
+    }
+
+    inline VkPhysicalDeviceTimelineSemaphoreFeaturesKHR get_physical_device_timeline_semaphore_features(
+        VkPhysicalDevice physical_device) {
+
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_features {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR
+        };
+        VkPhysicalDeviceFeatures2 features {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            .pNext = &timeline_features
+        };
+        vkGetPhysicalDeviceFeatures2(physical_device, &features);
+        timeline_features.pNext = nullptr;
+        return timeline_features;
+    }
+
+    inline VkPhysicalDeviceDescriptorIndexingPropertiesEXT get_physical_device_descriptor_indexing_properties(
+        VkPhysicalDevice physical_device) {
+
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexing_properties {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT
+        };
+        VkPhysicalDeviceProperties2 properties {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            .pNext = &indexing_properties
+        };
+        vkGetPhysicalDeviceProperties2(physical_device, &properties);
+        indexing_properties.pNext = nullptr;
+        return indexing_properties;
+    }
+
     inline std::vector<VkQueueFamilyProperties> get_queue_family_properties(
         VkPhysicalDevice physical_device) {
         
@@ -341,6 +503,24 @@ namespace stirling { namespace vulkan {
         return memory_requirements;
     }
 
+    inline VkMemoryRequirements get_image_memory_requirements(
+        VkDevice device,
+        VkImage  image) {
+
+        VkMemoryRequirements memory_requirements;
+        vkGetImageMemoryRequirements(device, image, &memory_requirements);
+        return memory_requirements;
+    }
+
+    inline VkFormatProperties get_physical_device_format_properties(
+        VkPhysicalDevice physical_device,
+        VkFormat         format) {
+
+        VkFormatProperties format_properties;
+        vkGetPhysicalDeviceFormatProperties(physical_device, format, &format_properties);
+        return format_properties;
+    }
+
     inline VkPhysicalDeviceMemoryProperties get_physical_device_memory_properties(
         VkPhysicalDevice physical_device) {
 
@@ -3,13 +3,46 @@
 #include <vulkan/vulkan.h>
 
 #include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
 namespace stirling { namespace vulkan {
 
-    template<typename To, typename From>
-    inline To cast_vector(const std::vector<From>& from) {
-        return from.size() > 0 ? std::vector<To>{from.begin(), from.end()}[0] : nullptr;
+    // Non-owning view of contiguous elements, built from braced lists, vectors and arrays without
+    // allocating. A view of a braced list is only valid until the end of the full expression.
+    template<typename T>
+    struct Span {
+        Span() : elements (nullptr), count (0) {}
+        Span(const T* elements, size_t count) : elements (elements), count (count) {}
+        Span(std::initializer_list<T> list) : elements (std::data(list)), count (list.size()) {}
+        Span(const std::vector<T>& vector) : elements (vector.data()), count (vector.size()) {}
+
+        template<size_t N>
+        Span(const T (&array)[N]) : elements (array), count (N) {}
+
+        inline const T* data() const { return elements; }
+        inline size_t size() const { return count; }
+        inline bool empty() const { return count == 0; }
+        inline const T* begin() const { return elements; }
+        inline const T* end() const { return elements + count; }
+        inline const T& operator[](size_t index) const { return elements[index]; }
+
+    private:
+        const T* elements;
+        size_t   count;
+    };
+
+    // Wrappers hold nothing but their Vulkan struct, so contiguous wrappers already form an array
+    // of it and the first one can be passed as the array pointer
+    template<typename To, typename Range>
+    inline To cast_vector(const Range& from) {
+        static_assert(
+            sizeof(*from.data()) == sizeof(std::remove_pointer_t<To>),
+            "Wrapper must have the size of the wrapped struct."
+        );
+        return from.size() > 0 ? static_cast<To>(from[0]) : nullptr;
     }
 
     template<typename To, typename From, typename Transformer>
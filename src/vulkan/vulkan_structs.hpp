@@ -158,7 +158,7 @@ namespace stirling { namespace vulkan {
         VkRenderPass              render_pass;
         VkFramebuffer             framebuffer;
         VkRect2D                  render_area;
-        std::vector<VkClearValue> clear_values;
+        Span<VkClearValue>        clear_values;
 
         inline operator const VkRenderPassBeginInfo() const {
             return {
@@ -210,17 +210,39 @@ namespace stirling { namespace vulkan {
     typedef Wrapper<CommandBufferBeginInfoData, VkCommandBufferBeginInfo> CommandBufferBeginInfo;
 
     struct SubmitInfoData {
-        std::vector<VkSemaphore>     wait_semaphores;
-        VkPipelineStageFlags         wait_dst_stage_mask;
-        std::vector<VkCommandBuffer> command_buffers;
-        std::vector<VkSemaphore>     signal_semaphores;
+        Span<VkSemaphore>          wait_semaphores;
+        Span<VkPipelineStageFlags> wait_dst_stage_masks;
+        Span<VkCommandBuffer>      command_buffers;
+        Span<VkSemaphore>          signal_semaphores;
+
+        // Values of timeline semaphores, one per semaphore when present, binary semaphores ignore theirs
+        Span<uint64_t>             wait_values;
+        Span<uint64_t>             signal_values;
+
+        mutable VkTimelineSemaphoreSubmitInfoKHR timeline_info;
 
         inline operator const VkSubmitInfo() const {
+            assert(wait_dst_stage_masks.size() == wait_semaphores.size());
+            assert(wait_values.empty() || wait_values.size() == wait_semaphores.size());
+            assert(signal_values.empty() || signal_values.size() == signal_semaphores.size());
+
+            const bool timeline = !wait_values.empty() || !signal_values.empty();
+            if (timeline) {
+                timeline_info = {
+                    .sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
+                    .waitSemaphoreValueCount   = static_cast<uint32_t>(wait_values.size()),
+                    .pWaitSemaphoreValues      = wait_values.data(),
+                    .signalSemaphoreValueCount = static_cast<uint32_t>(signal_values.size()),
+                    .pSignalSemaphoreValues    = signal_values.data()
+                };
+            }
+
             return {
                 .sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                .pNext                = timeline ? &timeline_info : nullptr,
                 .waitSemaphoreCount   = static_cast<uint32_t>(wait_semaphores.size()),
                 .pWaitSemaphores      = wait_semaphores.data(),
-                .pWaitDstStageMask    = &wait_dst_stage_mask,
+                .pWaitDstStageMask    = wait_dst_stage_masks.data(),
                 .commandBufferCount   = static_cast<uint32_t>(command_buffers.size()),
                 .pCommandBuffers      = command_buffers.data(),
                 .signalSemaphoreCount = static_cast<uint32_t>(signal_semaphores.size()),
@@ -231,9 +253,9 @@ namespace stirling { namespace vulkan {
     typedef Wrapper<SubmitInfoData, VkSubmitInfo> SubmitInfo;
 
     struct PresentInfoKHRData {
-        std::vector<VkSemaphore>    wait_semaphores;
-        std::vector<VkSwapchainKHR> swapchains;
-        std::vector<uint32_t>       image_indices;
+        Span<VkSemaphore>    wait_semaphores;
+        Span<VkSwapchainKHR> swapchains;
+        Span<uint32_t>       image_indices;
 
         inline operator const VkPresentInfoKHR() const {
             assert(image_indices.size() == swapchains.size());
@@ -2,6 +2,13 @@
 
 namespace stirling {
 
+    namespace {
+
+        // GLFW is shared by every window and terminated with the last one
+        uint32_t window_count = 0;
+
+    }
+
     Window::Window(uint32_t width, uint32_t height, const char* title) {
         glfwInit();
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
@@ -18,6 +25,7 @@ namespace stirling {
 
         window = glfwCreateWindow(width, height, title, nullptr/*monitor*/, nullptr);
         if (!window) throw "Failed to create window.";
+        ++window_count;
 
         //glfwSetWindowPos(window, 0, 0);
         glfwSetWindowPos(window, (mode->width - width) / 2, (mode->height - height) / 2);
@@ -29,7 +37,9 @@ namespace stirling {
     Window::~Window() {
         if (window != nullptr) {
             glfwDestroyWindow(window);
-            glfwTerminate();
+            if (--window_count == 0) {
+                glfwTerminate();
+            }
         }
     }
 
@@ -58,8 +68,11 @@ namespace stirling {
     }
 
     bool Window::should_close() const {
-        glfwPollEvents();
         return glfwWindowShouldClose(window);
     }
 
+    void Window::poll_events() {
+        glfwPollEvents();
+    }
+
 }
\ No newline at end of file
@@ -20,6 +20,9 @@ namespace stirling {
         std::vector<const char*> get_required_instance_extensions() const;
         bool should_close() const;
 
+        // Processes pending events of every window
+        static void poll_events();
+
     private:
         GLFWwindow* window;
     };
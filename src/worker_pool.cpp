@@ -0,0 +1,95 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+
+namespace stirling {
+
+    WorkerPool::WorkerPool(uint32_t worker_count) :
+        job            {nullptr, nullptr, 0, 0},
+        generation     (0),
+        active_workers (0),
+        stopping       (false),
+        next_chunk     (0) {
+
+        for (uint32_t i = 0; i < worker_count; ++i) {
+            workers.emplace_back([this]() { work(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        job_ready.notify_all();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    uint32_t WorkerPool::default_worker_count() {
+        const auto hardware_threads = std::thread::hardware_concurrency();
+        return hardware_threads > 1 ? hardware_threads - 1 : 0;
+    }
+
+    void WorkerPool::run(uint32_t count, uint32_t grain_size, TaskFunction function, const void* context) {
+        grain_size = std::max(grain_size, 1u);
+        if (workers.empty() || count <= grain_size) {
+            if (count > 0) function(context, 0, count);
+            return;
+        }
+
+        // Publish the job, workers and the caller then claim chunks until none are left
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = {function, context, count, grain_size};
+            next_chunk.store(0, std::memory_order_relaxed);
+            active_workers = static_cast<uint32_t>(workers.size());
+            ++generation;
+        }
+        job_ready.notify_all();
+
+        execute(job);
+
+        // Every worker has left the job once the count drops to zero, so the task may go out of scope
+        std::unique_lock<std::mutex> lock(mutex);
+        job_done.wait(lock, [this]() { return active_workers == 0; });
+    }
+
+    void WorkerPool::execute(const Job& job) {
+        const auto chunk_count = (job.count + job.grain_size - 1) / job.grain_size;
+        for (auto chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+             chunk < chunk_count;
+             chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+
+            const auto begin = chunk * job.grain_size;
+            job.function(job.context, begin, std::min(begin + job.grain_size, job.count));
+        }
+    }
+
+    void WorkerPool::work() {
+        uint64_t seen_generation = 0;
+        while (true) {
+            Job current_job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                job_ready.wait(lock, [&]() { return stopping || generation != seen_generation; });
+                if (stopping) return;
+
+                seen_generation = generation;
+                current_job = job;
+            }
+
+            execute(current_job);
+
+            bool last;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                last = --active_workers == 0;
+            }
+            if (last) job_done.notify_one();
+        }
+    }
+
+}
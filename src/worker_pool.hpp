@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace stirling {
+
+    // Persistent threads running one range task at a time. The calling thread takes chunks too, so a
+    // pool without workers runs tasks inline.
+    struct WorkerPool {
+        // Defaults to one worker less than the hardware threads, leaving one for the caller
+        WorkerPool(uint32_t worker_count = default_worker_count());
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Calls task(begin, end) over [0, count) in chunks of at most grain_size, returns once all
+        // chunks are done. Ranges at or below the grain size run inline without waking workers.
+        template<typename Task>
+        inline void parallel_for(uint32_t count, uint32_t grain_size, const Task& task) {
+            run(count, grain_size, [](const void* context, uint32_t begin, uint32_t end) {
+                (*static_cast<const Task*>(context))(begin, end);
+            }, &task);
+        }
+
+        inline uint32_t get_worker_count() const { return static_cast<uint32_t>(workers.size()); }
+
+        static uint32_t default_worker_count();
+
+    private:
+        using TaskFunction = void (*)(const void* context, uint32_t begin, uint32_t end);
+
+        struct Job {
+            TaskFunction function;
+            const void*  context;
+            uint32_t     count;
+            uint32_t     grain_size;
+        };
+
+        std::vector<std::thread> workers;
+        std::mutex               mutex;
+        std::condition_variable  job_ready;
+        std::condition_variable  job_done;
+        Job                      job;
+        uint64_t                 generation;
+        uint32_t                 active_workers;
+        bool                     stopping;
+        std::atomic<uint32_t>    next_chunk;
+
+        void run(uint32_t count, uint32_t grain_size, TaskFunction function, const void* context);
+        void execute(const Job& job);
+        void work();
+    };
+
+}
@@ -0,0 +1,166 @@
+#include "vulkan/command_buffer.hpp"
+#include "vulkan/queue.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Checks that the per-frame wrappers record and submit without touching the heap. The Vulkan
+// entry points are replaced by stubs defined here, which take precedence over the loader when
+// linking, so the test runs without a device and the stubs can check what reached them.
+
+namespace {
+
+    bool counting = false;
+    uint64_t allocation_count = 0;
+
+    uint32_t submitted_command_buffers = 0;
+    uint32_t presented_swapchains = 0;
+    uint32_t render_pass_clear_values = 0;
+    uint32_t bound_descriptor_sets = 0;
+    uint32_t bound_vertex_buffers = 0;
+
+    template<typename Handle>
+    Handle make_handle(uintptr_t value) {
+        return reinterpret_cast<Handle>(value);
+    }
+
+    int failures = 0;
+
+    void check(bool condition, const char* message) {
+        if (!condition) {
+            std::cerr << "FAILED: " << message << '\n';
+            ++failures;
+        }
+    }
+
+}
+
+void* operator new(size_t size) {
+    if (counting) ++allocation_count;
+    if (void* memory = std::malloc(size > 0 ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+extern "C" {
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkQueueSubmit(VkQueue, uint32_t submit_count, const VkSubmitInfo* submits, VkFence) {
+        for (uint32_t i = 0; i < submit_count; ++i) {
+            submitted_command_buffers += submits[i].commandBufferCount;
+        }
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkQueuePresentKHR(VkQueue, const VkPresentInfoKHR* present_info) {
+        presented_swapchains += present_info->swapchainCount;
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBeginRenderPass(VkCommandBuffer, const VkRenderPassBeginInfo* begin_info, VkSubpassContents) {
+        render_pass_clear_values += begin_info->clearValueCount;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBindDescriptorSets(
+        VkCommandBuffer, VkPipelineBindPoint, VkPipelineLayout, uint32_t, uint32_t descriptor_set_count,
+        const VkDescriptorSet*, uint32_t, const uint32_t*) {
+
+        bound_descriptor_sets += descriptor_set_count;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBindVertexBuffers(
+        VkCommandBuffer, uint32_t, uint32_t binding_count, const VkBuffer*, const VkDeviceSize*) {
+
+        bound_vertex_buffers += binding_count;
+    }
+
+}
+
+int main() {
+    using namespace stirling;
+
+    // Wrapper construction may allocate, only the recorded calls are counted
+    const vulkan::Queue queue{make_handle<VkQueue>(1)};
+    const vulkan::CommandBuffer command_buffer{Deleter<VkCommandBuffer>([](VkCommandBuffer) {}, make_handle<VkCommandBuffer>(2))};
+
+    const auto semaphore = make_handle<VkSemaphore>(3);
+    const auto timeline = make_handle<VkSemaphore>(4);
+    const auto swapchain = make_handle<VkSwapchainKHR>(5);
+    const auto render_pass = make_handle<VkRenderPass>(6);
+    const auto framebuffer = make_handle<VkFramebuffer>(7);
+    const auto layout = make_handle<VkPipelineLayout>(8);
+    const auto descriptor_set = make_handle<VkDescriptorSet>(9);
+    const auto vertex_buffer = make_handle<VkBuffer>(10);
+    const VkCommandBuffer command_buffer_handle = command_buffer;
+    const uint32_t image_index = 0;
+    const uint64_t frame_value = 1;
+
+    counting = true;
+
+    command_buffer.begin_render_pass({{
+        .render_pass  = render_pass,
+        .framebuffer  = framebuffer,
+        .render_area  = {
+            .offset = { 0, 0 },
+            .extent = { 640, 480 }
+        },
+        .clear_values = {
+            { 0.0f, 0.0f, 0.0f, 1.0f }
+        }
+    }}, VK_SUBPASS_CONTENTS_INLINE);
+
+    command_buffer.bind_descriptor_sets(VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, { descriptor_set }, {});
+    command_buffer.bind_vertex_buffers(0, { vertex_buffer }, { 0 });
+
+    queue.submit({
+        {{
+            .wait_semaphores      = { semaphore },
+            .wait_dst_stage_masks = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT },
+            .command_buffers      = { command_buffer_handle },
+            .signal_semaphores    = { semaphore, timeline },
+            .signal_values        = { 0, frame_value }
+        }}
+    });
+
+    queue.present({{
+        .wait_semaphores = { semaphore },
+        .swapchains      = { swapchain },
+        .image_indices   = { image_index }
+    }});
+
+    counting = false;
+
+    check(allocation_count == 0, "Recording, submitting and presenting allocated memory.");
+    check(render_pass_clear_values == 1, "Render pass did not receive its clear value.");
+    check(bound_descriptor_sets == 1, "Descriptor set was not bound.");
+    check(bound_vertex_buffers == 1, "Vertex buffer was not bound.");
+    check(submitted_command_buffers == 1, "Command buffer was not submitted.");
+    check(presented_swapchains == 1, "Swapchain was not presented.");
+
+    if (failures > 0) {
+        std::cerr << allocation_count << " allocations\n";
+        return 1;
+    }
+    std::cout << "No allocations in recorded calls\n";
+    return 0;
+}
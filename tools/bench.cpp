@@ -0,0 +1,164 @@
+#include "simd_math.hpp"
+#include "transform_hierarchy.hpp"
+#include "worker_pool.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Benchmarks the CPU side of the engine without opening a window:
+//
+//     stirling_bench [--transforms N] [--math N]
+//
+// Transforms animates a random hierarchy of N nodes, math compares the batched kernels at every
+// supported SIMD level against plain glm loops on N objects.
+
+namespace {
+
+    // Animates a random hierarchy of nodes and reports how long propagating the changes takes
+    void run_transform_benchmark(uint32_t node_count) {
+        using namespace stirling;
+
+        WorkerPool worker_pool;
+        TransformHierarchy transforms;
+        std::vector<TransformHandle> nodes;
+        std::mt19937 random;
+
+        nodes.push_back(transforms.create());
+        while (nodes.size() < node_count) {
+            nodes.push_back(transforms.create(nodes[random() % nodes.size()]));
+        }
+        transforms.update(&worker_pool);
+
+        // Every node animated, then one node near the root and one leaf moved per frame
+        constexpr uint32_t frame_count = 100;
+        const auto measure = [&](auto&& animate) {
+            std::chrono::steady_clock::duration total{0};
+            for (uint32_t frame = 0; frame < frame_count; ++frame) {
+                animate(static_cast<float>(frame));
+                const auto start = std::chrono::steady_clock::now();
+                transforms.update(&worker_pool);
+                total += std::chrono::steady_clock::now() - start;
+            }
+            return std::chrono::duration<double, std::milli>(total).count() / frame_count;
+        };
+
+        const auto all_nodes = measure([&](float frame) {
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                transforms.set_local(nodes[i], glm::rotate(glm::mat4(1.0f), frame * 0.01f + i, glm::vec3(0.0f, 0.0f, 1.0f)));
+            }
+        });
+        const auto one_node = measure([&](float frame) {
+            transforms.set_local(nodes[1], glm::translate(glm::mat4(1.0f), glm::vec3(frame, 0.0f, 0.0f)));
+        });
+        const auto one_leaf = measure([&](float frame) {
+            transforms.set_local(nodes.back(), glm::translate(glm::mat4(1.0f), glm::vec3(frame, 0.0f, 0.0f)));
+        });
+
+        std::cout << "Transform update of " << nodes.size() << " nodes with " << worker_pool.get_worker_count() << " workers: "
+                  << all_nodes << " ms with every node animated, " << one_node << " ms with one subtree moved, "
+                  << one_leaf << " ms with one leaf moved\n";
+    }
+
+    // Compares the batched kernels at every supported level against plain glm loops
+    void run_math_benchmark(uint32_t object_count) {
+        using namespace stirling;
+
+        std::mt19937 random;
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+        std::vector<glm::mat4> parents(object_count);
+        std::vector<glm::mat4> locals(object_count);
+        std::vector<glm::mat4> results(object_count);
+        std::vector<float> center_x(object_count), center_y(object_count), center_z(object_count);
+        std::vector<float> radius(object_count), extent_y(object_count), extent_z(object_count);
+        std::vector<uint32_t> visible_indices(object_count);
+
+        for (uint32_t i = 0; i < object_count; ++i) {
+            const glm::vec3 center(position(random), position(random), position(random));
+            parents[i] = glm::rotate(glm::mat4(1.0f), position(random), glm::vec3(0.0f, 1.0f, 0.0f));
+            locals[i] = glm::translate(glm::mat4(1.0f), center);
+            center_x[i] = center.x;
+            center_y[i] = center.y;
+            center_z[i] = center.z;
+            radius[i] = size(random);
+            extent_y[i] = size(random);
+            extent_z[i] = size(random);
+        }
+
+        const auto view_projection =
+            glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 200.0f) *
+            glm::lookAt(glm::vec3(0.0f, 0.0f, -50.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const auto frustum = make_frustum(view_projection);
+        const BoundingSpheres spheres = { center_x.data(), center_y.data(), center_z.data(), radius.data() };
+        const BoundingBoxes boxes = {
+            center_x.data(), center_y.data(), center_z.data(), radius.data(), extent_y.data(), extent_z.data()
+        };
+
+        // Best of several runs, in microseconds
+        const auto measure = [](auto&& kernel) {
+            double best = std::numeric_limits<double>::max();
+            for (uint32_t run = 0; run < 20; ++run) {
+                const auto start = std::chrono::steady_clock::now();
+                kernel();
+                best = std::min(best, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+            return best;
+        };
+
+        std::cout << "Math kernels on " << object_count << " objects, times in microseconds\n";
+        std::cout << "glm: "
+                  << measure([&]() { for (uint32_t i = 0; i < object_count; ++i) results[i] = parents[i] * locals[i]; }) << " concatenate, "
+                  << measure([&]() { for (uint32_t i = 0; i < object_count; ++i) results[i] = view_projection * locals[i]; }) << " world-view-projection\n";
+
+        const auto supported_level = static_cast<uint32_t>(get_supported_simd_level());
+        for (uint32_t level = 0; level <= supported_level; ++level) {
+            set_simd_level(static_cast<SimdLevel>(level));
+
+            size_t visible_spheres = 0;
+            size_t visible_boxes = 0;
+            std::cout << get_simd_level_name(get_simd_level()) << ": "
+                      << measure([&]() { multiply_matrices(parents.data(), locals.data(), results.data(), object_count); }) << " concatenate, "
+                      << measure([&]() { multiply_matrices(view_projection, locals.data(), results.data(), object_count); }) << " world-view-projection, "
+                      << measure([&]() { visible_spheres = cull_spheres(frustum, spheres, object_count, 0, visible_indices.data()); }) << " sphere culling, "
+                      << measure([&]() { visible_boxes = cull_boxes(frustum, boxes, object_count, 0, visible_indices.data()); }) << " box culling ("
+                      << visible_spheres << " spheres and " << visible_boxes << " boxes visible)\n";
+        }
+        set_simd_level(get_supported_simd_level());
+    }
+
+}
+
+int main(int argc, char** argv) {
+    uint32_t transform_count = 0;
+    uint32_t math_count = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const auto has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--transforms") == 0 && has_value) {
+            transform_count = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--math") == 0 && has_value) {
+            math_count = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cerr << "Unknown argument " << argv[i] << '\n';
+            return 1;
+        }
+    }
+
+    if (transform_count == 0 && math_count == 0) {
+        std::cerr << "usage: " << argv[0] << " [--transforms N] [--math N]\n";
+        return 1;
+    }
+
+    if (transform_count > 0) run_transform_benchmark(transform_count);
+    if (math_count > 0) run_math_benchmark(math_count);
+    return 0;
+}
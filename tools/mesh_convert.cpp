@@ -0,0 +1,196 @@
+#include "file.hpp"
+#include "hash.hpp"
+#include "mesh_builder.hpp"
+#include "mesh_file.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Converts Wavefront OBJ files into the binary mesh format:
+//
+//     stirling_mesh [--lods N] model.obj model.mesh
+//
+// Supports positions with optional vertex colors (v x y z r g b), texture coordinates,
+// normals and polygonal faces, which are triangulated as fans. Up to N levels of detail,
+// including the full mesh, are generated by simplification, --lods 1 stores the full mesh only.
+
+namespace {
+
+    struct VertexKey {
+        int32_t position;
+        int32_t uv;
+        int32_t normal;
+
+        bool operator==(const VertexKey& rhs) const {
+            return position == rhs.position && uv == rhs.uv && normal == rhs.normal;
+        }
+    };
+
+    struct VertexKeyHash {
+        size_t operator()(const VertexKey& key) const {
+            return static_cast<size_t>(stirling::hash_value(key));
+        }
+    };
+
+    const char* skip_spaces(const char* it, const char* end) {
+        while (it < end && (*it == ' ' || *it == '\t')) ++it;
+        return it;
+    }
+
+    // Parses up to count floats from the rest of the line, returns how many were read
+    int parse_floats(const char* it, const char* end, float* values, int count) {
+        int parsed = 0;
+        std::string number;
+        while (parsed < count) {
+            it = skip_spaces(it, end);
+            const auto start = it;
+            while (it < end && *it != ' ' && *it != '\t') ++it;
+            if (it == start) break;
+            number.assign(start, it);
+            values[parsed++] = std::strtof(number.c_str(), nullptr);
+        }
+        return parsed;
+    }
+
+    // OBJ indices are one-based, negative indices count back from the latest element
+    int32_t resolve_index(long index, size_t count) {
+        if (index > 0) return static_cast<int32_t>(index - 1);
+        if (index < 0) return static_cast<int32_t>(count + index);
+        return -1;
+    }
+
+    stirling::SourceMesh load_obj(const char* file_name) {
+        const FileView file{file_name};
+        const auto begin = reinterpret_cast<const char*>(file.data());
+        const auto end = begin + file.size();
+
+        std::vector<float> positions;
+        std::vector<float> colors;
+        std::vector<float> uvs;
+        std::vector<float> normals;
+
+        stirling::SourceMesh mesh;
+        std::unordered_map<VertexKey, uint32_t, VertexKeyHash> vertex_indices;
+        std::vector<uint32_t> face;
+        std::string token;
+
+        for (auto line = begin; line < end;) {
+            auto line_end = static_cast<const char*>(memchr(line, '\n', end - line));
+            if (line_end == nullptr) line_end = end;
+            const auto it = skip_spaces(line, line_end);
+
+            if (line_end - it > 2 && it[0] == 'v' && it[1] == ' ') {
+                float values[6] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+                parse_floats(it + 2, line_end, values, 6);
+                positions.insert(positions.end(), values, values + 3);
+                colors.insert(colors.end(), values + 3, values + 6);
+            } else if (line_end - it > 3 && it[0] == 'v' && it[1] == 't' && it[2] == ' ') {
+                float values[2] = { 0.0f, 0.0f };
+                parse_floats(it + 3, line_end, values, 2);
+                uvs.insert(uvs.end(), values, values + 2);
+            } else if (line_end - it > 3 && it[0] == 'v' && it[1] == 'n' && it[2] == ' ') {
+                float values[3] = { 0.0f, 0.0f, 0.0f };
+                parse_floats(it + 3, line_end, values, 3);
+                normals.insert(normals.end(), values, values + 3);
+            } else if (line_end - it > 2 && it[0] == 'f' && it[1] == ' ') {
+                face.clear();
+                for (auto corner = skip_spaces(it + 2, line_end); corner < line_end; corner = skip_spaces(corner, line_end)) {
+                    auto corner_end = corner;
+                    while (corner_end < line_end && *corner_end != ' ' && *corner_end != '\t' && *corner_end != '\r') ++corner_end;
+                    if (corner_end == corner) break;
+                    token.assign(corner, corner_end);
+                    corner = corner_end;
+
+                    // Corner is v, v/vt, v//vn or v/vt/vn
+                    VertexKey key { -1, -1, -1 };
+                    char* next = nullptr;
+                    key.position = resolve_index(std::strtol(token.c_str(), &next, 10), positions.size() / 3);
+                    if (*next == '/') {
+                        ++next;
+                        if (*next != '/') key.uv = resolve_index(std::strtol(next, &next, 10), uvs.size() / 2);
+                        if (*next == '/') key.normal = resolve_index(std::strtol(next + 1, &next, 10), normals.size() / 3);
+                    }
+                    if (key.position < 0 || key.position >= static_cast<int32_t>(positions.size() / 3)) {
+                        throw "Invalid OBJ face index.";
+                    }
+
+                    const auto found = vertex_indices.find(key);
+                    if (found != vertex_indices.end()) {
+                        face.push_back(found->second);
+                        continue;
+                    }
+
+                    stirling::SourceVertex vertex {};
+                    memcpy(vertex.position, &positions[key.position * 3], sizeof(vertex.position));
+                    memcpy(vertex.color, &colors[key.position * 3], sizeof(vertex.color));
+                    if (key.uv >= 0 && key.uv < static_cast<int32_t>(uvs.size() / 2)) {
+                        memcpy(vertex.uv, &uvs[key.uv * 2], sizeof(vertex.uv));
+                    }
+                    if (key.normal >= 0 && key.normal < static_cast<int32_t>(normals.size() / 3)) {
+                        memcpy(vertex.normal, &normals[key.normal * 3], sizeof(vertex.normal));
+                    }
+
+                    const auto index = static_cast<uint32_t>(mesh.vertices.size());
+                    mesh.vertices.push_back(vertex);
+                    vertex_indices.emplace(key, index);
+                    face.push_back(index);
+                }
+
+                // Triangulate as a fan
+                for (size_t i = 2; i < face.size(); ++i) {
+                    mesh.indices.push_back(face[0]);
+                    mesh.indices.push_back(face[i - 1]);
+                    mesh.indices.push_back(face[i]);
+                }
+            }
+
+            line = line_end + 1;
+        }
+
+        return mesh;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const auto program = argv[0];
+    uint32_t lod_count = stirling::mesh_max_lods;
+    if (argc == 5 && strcmp(argv[1], "--lods") == 0) {
+        lod_count = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+        argv += 2;
+        argc -= 2;
+    }
+    if (argc != 3 || lod_count < 1 || lod_count > stirling::mesh_max_lods) {
+        std::cerr << "usage: " << program << " [--lods 1-" << stirling::mesh_max_lods << "] <input.obj> <output.mesh>\n";
+        return 1;
+    }
+
+    try {
+        stirling::MeshBuilder builder{load_obj(argv[1])};
+        const auto input_statistics = builder.get_statistics();
+        builder.build_lods(lod_count);
+        builder.optimize();
+        const auto output_statistics = builder.get_statistics();
+        builder.write(argv[2]);
+
+        const auto& mesh = builder.get_mesh();
+        std::cout << argv[2] << ": " << mesh.vertices.size() << " vertices, "
+                  << mesh.indices.size() / 3 << " triangles, "
+                  << builder.get_index_size() * 8 << " bit indices\n"
+                  << "ACMR " << input_statistics.acmr << " -> " << output_statistics.acmr
+                  << ", ATVR " << input_statistics.atvr << " -> " << output_statistics.atvr << '\n';
+        for (size_t i = 0; i < mesh.lods.size(); ++i) {
+            std::cout << "LOD " << i + 1 << ": " << mesh.lods[i].indices.size() / 3 << " triangles, error "
+                      << mesh.lods[i].error << '\n';
+        }
+    } catch (const char* message) {
+        std::cerr << message << '\n';
+        return 1;
+    }
+    return 0;
+}
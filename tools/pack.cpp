@@ -0,0 +1,44 @@
+#include "archive.hpp"
+#include "file.hpp"
+
+#include <cstring>
+#include <iostream>
+
+// Packs files into a single archive. Compression flags apply to every file listed after them:
+//
+//     stirling_pack assets.pak vert.spv geom.spv frag.spv --lz4 mesh.bin --none font.ktx2
+//
+// Entries are named by the path exactly as given on the command line.
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <archive> [--none|--lz4|--zstd] <file>...\n";
+        return 1;
+    }
+
+    try {
+        stirling::ArchiveBuilder builder;
+        auto compression = stirling::ArchiveCompression::none;
+
+        for (int i = 2; i < argc; ++i) {
+            if (strcmp(argv[i], "--none") == 0) {
+                compression = stirling::ArchiveCompression::none;
+            } else if (strcmp(argv[i], "--lz4") == 0) {
+                compression = stirling::ArchiveCompression::lz4;
+            } else if (strcmp(argv[i], "--zstd") == 0) {
+                compression = stirling::ArchiveCompression::zstd;
+            } else {
+                if (!stirling::is_compression_supported(compression)) {
+                    throw "Archive compression not supported by this build.";
+                }
+                const FileView file{argv[i]};
+                builder.add(argv[i], file.data(), file.size(), compression);
+            }
+        }
+
+        builder.write(argv[1]);
+    } catch (const char* message) {
+        std::cerr << message << '\n';
+        return 1;
+    }
+    return 0;
+}